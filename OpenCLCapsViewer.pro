@@ -1,6 +1,6 @@
 TEMPLATE = app
 TARGET = OpenCLCapsViewer
-QT += core network widgets gui
+QT += core network widgets gui concurrent
 CONFIG += c++17
 DEFINES += GUI_BUILD
 DEFINES += QT_DLL QT_NETWORK_LIB QT_WIDGETS_LIB
@@ -31,6 +31,32 @@ SOURCES += \
     settingsdialog.cpp \
     appinfo.cpp \
     report.cpp \
+    reportstore.cpp \
+    benchmark.cpp \
+    benchmarkvectoradd.cpp \
+    benchmarkbandwidth.cpp \
+    benchmarktransfer.cpp \
+    benchmarklatency.cpp \
+    benchmarkcompute.cpp \
+    benchmarklocalmemory.cpp \
+    benchmarkatomics.cpp \
+    benchmarkcache.cpp \
+    benchmarkbuild.cpp \
+    benchmarkimages.cpp \
+    benchmarksvm.cpp \
+    benchmarksubgroups.cpp \
+    benchmarkqueues.cpp \
+    benchmarkdotproduct.cpp \
+    benchmarkcommandbuffer.cpp \
+    benchmarkdeviceenqueue.cpp \
+    benchmarkpartitions.cpp \
+    benchmarkroofline.cpp \
+    benchmarktimers.cpp \
+    programcache.cpp \
+    autotuner.cpp \
+    roofline.cpp \
+    rooflinechart.cpp \
+    timercalibration.cpp \
     operatingsystem.cpp
 
 HEADERS += \
@@ -47,6 +73,14 @@ HEADERS += \
     settingsdialog.h \
     appinfo.h \
     report.h \
+    reportstore.h \
+    benchmark.h \
+    benchmarks.h \
+    programcache.h \
+    autotuner.h \
+    roofline.h \
+    rooflinechart.h \
+    timercalibration.h \
     operatingsystem.h
 
 FORMS += \
@@ -1,6 +1,6 @@
 TEMPLATE = app
 TARGET = OpenCLCapsViewer
-QT       += core network
+QT       += core network concurrent
 #greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 CONFIG += c++11
 CONFIG += console
@@ -26,6 +26,31 @@ SOURCES += \
     settings.cpp \
     appinfo.cpp \
     report.cpp \
+    reportstore.cpp \
+    benchmark.cpp \
+    benchmarkvectoradd.cpp \
+    benchmarkbandwidth.cpp \
+    benchmarktransfer.cpp \
+    benchmarklatency.cpp \
+    benchmarkcompute.cpp \
+    benchmarklocalmemory.cpp \
+    benchmarkatomics.cpp \
+    benchmarkcache.cpp \
+    benchmarkbuild.cpp \
+    benchmarkimages.cpp \
+    benchmarksvm.cpp \
+    benchmarksubgroups.cpp \
+    benchmarkqueues.cpp \
+    benchmarkdotproduct.cpp \
+    benchmarkcommandbuffer.cpp \
+    benchmarkdeviceenqueue.cpp \
+    benchmarkpartitions.cpp \
+    benchmarkroofline.cpp \
+    benchmarktimers.cpp \
+    programcache.cpp \
+    autotuner.cpp \
+    roofline.cpp \
+    timercalibration.cpp \
     operatingsystem.cpp
 
 HEADERS += \
@@ -39,6 +64,13 @@ HEADERS += \
     settings.h \
     appinfo.h \
     report.h \
+    reportstore.h \
+    benchmark.h \
+    benchmarks.h \
+    programcache.h \
+    autotuner.h \
+    roofline.h \
+    timercalibration.h \
     operatingsystem.h
 
 INCLUDEPATH += "external/OpenCL-Headers"
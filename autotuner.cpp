@@ -0,0 +1,747 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "autotuner.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QFile>
+#include <QDir>
+#include <random>
+#include <cmath>
+
+static const char* localSizeNames[] = { "LOCAL_SIZE_X", "LOCAL_SIZE_Y", "LOCAL_SIZE_Z" };
+
+// Spaces with up to this many candidates are searched exhaustively in auto mode
+static const size_t maxGridCandidates = 64;
+// Coordinate descent rounds of the heuristic search, it usually converges after two
+static const int maxDescentRounds = 4;
+
+static bool parseScaledSize(const QJsonValue& value, TuningSpace::ScaledSize& size)
+{
+    if (value.isDouble()) {
+        size.size = quint64(value.toDouble());
+        return size.size > 0;
+    }
+    if (!value.isObject()) {
+        return false;
+    }
+    const QJsonObject object = value.toObject();
+    size.size = quint64(object["size"].toDouble());
+    for (const QJsonValue& name : object["multiplyBy"].toArray()) {
+        size.multiplyBy.append(name.toString());
+    }
+    for (const QJsonValue& name : object["divideBy"].toArray()) {
+        size.divideBy.append(name.toString());
+    }
+    return size.size > 0;
+}
+
+bool TuningSpace::load(const QString& fileName, QString& error)
+{
+    this->fileName = fileName;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Could not open tuning space " + fileName;
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if ((parseError.error != QJsonParseError::NoError) || !document.isObject()) {
+        error = "Could not parse tuning space " + fileName + ": " + parseError.errorString();
+        return false;
+    }
+    const QJsonObject json = document.object();
+
+    kernelName = json["kernel"].toString();
+    if (kernelName.isEmpty()) {
+        error = "Tuning space does not name a kernel";
+        return false;
+    }
+    // The source file is relative to the tuning space
+    sourceFile = QFileInfo(fileName).dir().filePath(json["source"].toString());
+    QFile sourceData(sourceFile);
+    if (json["source"].toString().isEmpty() || !sourceData.open(QIODevice::ReadOnly)) {
+        error = "Could not open kernel source " + sourceFile;
+        return false;
+    }
+    source = QString::fromUtf8(sourceData.readAll());
+    options = json["options"].toString();
+    search = json["search"].toString("auto");
+    if ((search != "auto") && (search != "grid") && (search != "heuristic")) {
+        error = "Unknown search \"" + search + "\", expected auto, grid or heuristic";
+        return false;
+    }
+    defineLocalSize = json["defineLocalSize"].toBool(false);
+
+    const QJsonArray jsonGlobalSize = json["globalSize"].toArray();
+    if (jsonGlobalSize.isEmpty() || (jsonGlobalSize.size() > 3)) {
+        error = "Global size needs to have one to three dimensions";
+        return false;
+    }
+    for (const QJsonValue& value : jsonGlobalSize) {
+        ScaledSize size;
+        if (!parseScaledSize(value, size)) {
+            error = "Invalid global size";
+            return false;
+        }
+        globalSize.push_back(size);
+    }
+
+    const QJsonObject jsonParameters = json["parameters"].toObject();
+    for (auto it = jsonParameters.begin(); it != jsonParameters.end(); ++it) {
+        Parameter parameter;
+        parameter.name = it.key();
+        for (const QJsonValue& value : it.value().toArray()) {
+            parameter.values.push_back(qint64(value.toDouble()));
+        }
+        if (parameter.values.empty()) {
+            error = "Tuning parameter " + parameter.name + " has no values";
+            return false;
+        }
+        parameters.push_back(parameter);
+    }
+
+    for (const QJsonValue& value : json["localSizes"].toArray()) {
+        std::vector<size_t> localSize;
+        for (const QJsonValue& dimension : value.toArray()) {
+            localSize.push_back(size_t(dimension.toDouble()));
+        }
+        if ((localSize.size() != globalSize.size()) || std::count(localSize.begin(), localSize.end(), size_t(0)) > 0) {
+            error = "Work group sizes need to match the dimensions of the global size";
+            return false;
+        }
+        localSizes.push_back(localSize);
+    }
+
+    for (const QJsonValue& value : json["arguments"].toArray()) {
+        const QJsonObject jsonArgument = value.toObject();
+        const QString type = jsonArgument["type"].toString();
+        Argument argument;
+        if ((type == "buffer") || (type == "local")) {
+            argument.type = (type == "buffer") ? Argument::Type::Buffer : Argument::Type::Local;
+            if (!parseScaledSize(jsonArgument, argument.size)) {
+                error = "Invalid size for " + type + " argument";
+                return false;
+            }
+        } else if ((type == "int") || (type == "uint") || (type == "float")) {
+            argument.type = (type == "int") ? Argument::Type::Int : ((type == "uint") ? Argument::Type::UInt : Argument::Type::Float);
+            argument.value = jsonArgument["value"].toDouble();
+        } else {
+            error = "Unknown argument type \"" + type + "\"";
+            return false;
+        }
+        arguments.push_back(argument);
+    }
+
+    // Global sizes can only depend on tuning parameters, buffers are allocated once and can't be scaled at all
+    auto knownName = [this](const QString& name, bool allowLocalSize) {
+        for (cl_uint i = 0; i < globalSize.size(); i++) {
+            if (allowLocalSize && (name == localSizeNames[i])) {
+                return true;
+            }
+        }
+        return std::any_of(parameters.begin(), parameters.end(), [&name](const Parameter& parameter) { return parameter.name == name; });
+    };
+    auto checkNames = [&](const ScaledSize& size, bool allowLocalSize) {
+        for (auto& name : size.multiplyBy + size.divideBy) {
+            if (!knownName(name, allowLocalSize)) {
+                error = "Unknown tuning parameter " + name;
+                return false;
+            }
+        }
+        return true;
+    };
+    for (auto& size : globalSize) {
+        if (!checkNames(size, false)) {
+            return false;
+        }
+    }
+    for (auto& argument : arguments) {
+        if ((argument.type == Argument::Type::Buffer) && !(argument.size.multiplyBy.isEmpty() && argument.size.divideBy.isEmpty())) {
+            error = "Buffer sizes can't depend on tuning parameters";
+            return false;
+        }
+        if ((argument.type == Argument::Type::Local) && !checkNames(argument.size, true)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Autotuner::Autotuner(DeviceInfo& device, const BenchmarkSettings& settings) : context(device, settings)
+{
+}
+
+qint64 Autotuner::resolve(const QString& name, const std::vector<size_t>& candidate)
+{
+    for (size_t i = 0; i < 3; i++) {
+        if (name == localSizeNames[i]) {
+            const std::vector<size_t>& localSize = localSizes[candidate.back()];
+            return (i < localSize.size()) ? qint64(localSize[i]) : 1;
+        }
+    }
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        if (space.parameters[i].name == name) {
+            return space.parameters[i].values[candidate[i]];
+        }
+    }
+    return 0;
+}
+
+// Returns zero if the size is not valid for the candidate, e.g. not evenly divisible
+quint64 Autotuner::scaledSize(const TuningSpace::ScaledSize& size, const std::vector<size_t>& candidate)
+{
+    quint64 value = size.size;
+    for (auto& name : size.multiplyBy) {
+        const qint64 factor = resolve(name, candidate);
+        if (factor <= 0) {
+            return 0;
+        }
+        value *= quint64(factor);
+    }
+    for (auto& name : size.divideBy) {
+        const qint64 divisor = resolve(name, candidate);
+        if ((divisor <= 0) || (value % quint64(divisor) != 0)) {
+            return 0;
+        }
+        value /= quint64(divisor);
+    }
+    return value;
+}
+
+QString Autotuner::buildOptions(const std::vector<size_t>& candidate)
+{
+    QString options = space.options;
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        options += QString(" -D%1=%2").arg(space.parameters[i].name).arg(space.parameters[i].values[candidate[i]]);
+    }
+    if (space.defineLocalSize) {
+        for (size_t i = 0; i < space.globalSize.size(); i++) {
+            options += QString(" -D%1=%2").arg(localSizeNames[i]).arg(resolve(localSizeNames[i], candidate));
+        }
+    }
+    return options.trimmed();
+}
+
+QString Autotuner::describe(const std::vector<size_t>& candidate)
+{
+    QStringList parts;
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        parts.append(QString("%1=%2").arg(space.parameters[i].name).arg(space.parameters[i].values[candidate[i]]));
+    }
+    QStringList localSize;
+    for (size_t dimension : localSizes[candidate.back()]) {
+        localSize.append(QString::number(dimension));
+    }
+    parts.append("work group size " + localSize.join("x"));
+    return parts.join(", ");
+}
+
+cl_kernel Autotuner::kernel(const std::vector<size_t>& candidate)
+{
+    const QString options = buildOptions(candidate);
+    auto it = kernels.find(options);
+    if (it != kernels.end()) {
+        return it->second;
+    }
+    QString error;
+    cl_kernel candidateKernel = nullptr;
+    cl_program program = context.buildProgram(space.source, options, error);
+    if (program) {
+        candidateKernel = context.createKernel(program, space.kernelName.toLatin1().constData(), error);
+    }
+    if (!candidateKernel) {
+        // Parameter combinations that don't compile are part of the search, e.g. tiles exceeding the local memory
+        qWarning() << "Could not build tuning candidate with" << options << ":" << error;
+        failedBuilds++;
+        lastError = error;
+    }
+    kernels[options] = candidateKernel;
+    return candidateKernel;
+}
+
+// Returns the median kernel time in nanoseconds, or a negative value if the candidate can't be run
+// With driverLocalSize set, the work group size of the candidate is ignored and left to the implementation
+double Autotuner::evaluate(const std::vector<size_t>& candidate, bool driverLocalSize)
+{
+    if (!driverLocalSize) {
+        auto it = candidateTimes.find(candidate);
+        if (it != candidateTimes.end()) {
+            return it->second;
+        }
+    }
+    double time = -1.0;
+    const std::vector<size_t>& localSize = localSizes[candidate.back()];
+    std::vector<size_t> globalSize;
+    size_t workGroupSize = 1;
+    bool valid = true;
+    for (size_t i = 0; i < space.globalSize.size(); i++) {
+        const quint64 size = scaledSize(space.globalSize[i], candidate);
+        // Non-uniform work groups are not available before OpenCL 2.0, so the global size needs to be a multiple of the work group size
+        valid &= (size > 0) && (driverLocalSize || (size % localSize[i] == 0));
+        globalSize.push_back(size_t(size));
+        workGroupSize *= localSize[i];
+    }
+    cl_kernel candidateKernel = valid ? kernel(candidate) : nullptr;
+    if (candidateKernel) {
+        for (size_t i = 0; (i < space.arguments.size()) && valid; i++) {
+            const TuningSpace::Argument& argument = space.arguments[i];
+            const cl_uint index = cl_uint(i);
+            cl_int status = CL_SUCCESS;
+            switch (argument.type) {
+            case TuningSpace::Argument::Type::Buffer:
+                status = _clSetKernelArg(candidateKernel, index, sizeof(cl_mem), &buffers[i]);
+                break;
+            case TuningSpace::Argument::Type::Local: {
+                const quint64 size = scaledSize(argument.size, candidate);
+                valid = (size > 0);
+                status = valid ? _clSetKernelArg(candidateKernel, index, size_t(size), nullptr) : CL_SUCCESS;
+                break;
+            }
+            case TuningSpace::Argument::Type::Int: {
+                const cl_int value = cl_int(argument.value);
+                status = _clSetKernelArg(candidateKernel, index, sizeof(cl_int), &value);
+                break;
+            }
+            case TuningSpace::Argument::Type::UInt: {
+                const cl_uint value = cl_uint(argument.value);
+                status = _clSetKernelArg(candidateKernel, index, sizeof(cl_uint), &value);
+                break;
+            }
+            case TuningSpace::Argument::Type::Float: {
+                const cl_float value = cl_float(argument.value);
+                status = _clSetKernelArg(candidateKernel, index, sizeof(cl_float), &value);
+                break;
+            }
+            }
+            if (status != CL_SUCCESS) {
+                lastError = QString("Could not set kernel argument %1: ").arg(index) + utils::errorString(status);
+                valid = false;
+            }
+        }
+        // Limits of the compiled kernel, the local memory size includes the local memory arguments set above
+        size_t maxWorkGroupSize = 0;
+        cl_ulong localMemSize = 0;
+        _clGetKernelWorkGroupInfo(candidateKernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxWorkGroupSize, nullptr);
+        _clGetKernelWorkGroupInfo(candidateKernel, context.device.deviceId, CL_KERNEL_LOCAL_MEM_SIZE, sizeof(cl_ulong), &localMemSize, nullptr);
+        valid &= (driverLocalSize || (workGroupSize <= maxWorkGroupSize)) && (localMemSize <= context.deviceValue<cl_ulong>(CL_DEVICE_LOCAL_MEM_SIZE));
+        if (valid) {
+            BenchmarkTimings timings;
+            QString error;
+            if (context.timeKernel(candidateKernel, cl_uint(globalSize.size()), globalSize.data(), driverLocalSize ? nullptr : localSize.data(), timings, error)) {
+                time = timings.median();
+            } else {
+                qWarning() << "Could not run tuning candidate" << describe(candidate) << ":" << error;
+                lastError = error;
+            }
+        }
+    }
+    if (!driverLocalSize) {
+        candidateTimes[candidate] = time;
+    }
+    return time;
+}
+
+// Steps to the next candidate of the full space, returns false after the last one
+bool Autotuner::nextCandidate(std::vector<size_t>& candidate)
+{
+    for (size_t i = 0; i < candidate.size(); i++) {
+        if (++candidate[i] < radix[i]) {
+            return true;
+        }
+        candidate[i] = 0;
+    }
+    return false;
+}
+
+// Powers of two up to the device limits, kernel specific limits are checked when evaluating a candidate
+void Autotuner::generateLocalSizes()
+{
+    size_t valueSize = 0;
+    _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_MAX_WORK_ITEM_SIZES, 0, nullptr, &valueSize);
+    std::vector<size_t> maxWorkItemSizes(std::max(valueSize / sizeof(size_t), size_t(3)), 1);
+    _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_MAX_WORK_ITEM_SIZES, valueSize, maxWorkItemSizes.data(), nullptr);
+    const size_t maxWorkGroupSize = context.deviceValue<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE);
+
+    localSizes = { {} };
+    for (size_t dimension = 0; dimension < space.globalSize.size(); dimension++) {
+        std::vector<std::vector<size_t>> extended;
+        for (auto& localSize : localSizes) {
+            size_t workGroupSize = 1;
+            for (size_t size : localSize) {
+                workGroupSize *= size;
+            }
+            for (size_t size = 1; (size <= maxWorkItemSizes[dimension]) && (size <= 1024) && (workGroupSize * size <= maxWorkGroupSize); size *= 2) {
+                extended.push_back(localSize);
+                extended.back().push_back(size);
+            }
+        }
+        localSizes = extended;
+    }
+}
+
+// Work group sizes that aren't a multiple of the preferred multiple leave SIMD lanes unused, so they're dropped from the heuristic search
+void Autotuner::pruneLocalSizes()
+{
+    std::vector<size_t> candidate(radix.size(), 0);
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        candidate[i] = radix[i] / 2;
+    }
+    cl_kernel probeKernel = kernel(candidate);
+    size_t preferredMultiple = 1;
+    if (probeKernel) {
+        _clGetKernelWorkGroupInfo(probeKernel, context.device.deviceId, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, sizeof(size_t), &preferredMultiple, nullptr);
+    }
+    std::vector<std::vector<size_t>> pruned;
+    for (auto& localSize : localSizes) {
+        size_t workGroupSize = 1;
+        for (size_t size : localSize) {
+            workGroupSize *= size;
+        }
+        if (workGroupSize % std::max(preferredMultiple, size_t(1)) == 0) {
+            pruned.push_back(localSize);
+        }
+    }
+    if (!pruned.empty()) {
+        localSizes = pruned;
+        radix.back() = localSizes.size();
+    }
+}
+
+std::vector<size_t> Autotuner::gridSearch()
+{
+    std::vector<size_t> candidate(radix.size(), 0);
+    std::vector<size_t> best;
+    double bestTime = -1.0;
+    do {
+        const double time = evaluate(candidate);
+        if ((time >= 0.0) && ((bestTime < 0.0) || (time < bestTime))) {
+            best = candidate;
+            bestTime = time;
+        }
+    } while (nextCandidate(candidate));
+    return best;
+}
+
+// Coordinate descent: starting from the middle of each parameter range and a work group size close to 256 work items,
+// each index is varied on its own while keeping the others at the best values found so far, until a round brings no improvement
+std::vector<size_t> Autotuner::heuristicSearch()
+{
+    pruneLocalSizes();
+    std::vector<size_t> best(radix.size(), 0);
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        best[i] = radix[i] / 2;
+    }
+    const double targetSize = std::log2(double(std::min(context.deviceValue<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE), size_t(256))));
+    double closest = -1.0;
+    for (size_t i = 0; i < localSizes.size(); i++) {
+        double workGroupSize = 1.0;
+        for (size_t size : localSizes[i]) {
+            workGroupSize *= double(size);
+        }
+        const double distance = std::abs(std::log2(workGroupSize) - targetSize);
+        if ((closest < 0.0) || (distance < closest)) {
+            closest = distance;
+            best.back() = i;
+        }
+    }
+
+    double bestTime = evaluate(best);
+    if (bestTime < 0.0) {
+        // Fall back to the first valid candidate of the full space
+        std::vector<size_t> candidate(radix.size(), 0);
+        do {
+            bestTime = evaluate(candidate);
+            if (bestTime >= 0.0) {
+                best = candidate;
+                break;
+            }
+        } while (nextCandidate(candidate));
+        if (bestTime < 0.0) {
+            return {};
+        }
+    }
+    for (int round = 0; round < maxDescentRounds; round++) {
+        bool improved = false;
+        for (size_t index = 0; index < radix.size(); index++) {
+            const size_t current = best[index];
+            for (size_t value = 0; value < radix[index]; value++) {
+                if (value == current) {
+                    continue;
+                }
+                std::vector<size_t> candidate = best;
+                candidate[index] = value;
+                const double time = evaluate(candidate);
+                if ((time >= 0.0) && (time < bestTime)) {
+                    best = candidate;
+                    bestTime = time;
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) {
+            break;
+        }
+    }
+    return best;
+}
+
+bool Autotuner::tune(const QString& spaceFile, QString& result, QString& error)
+{
+    if (!space.load(spaceFile, error) || !context.create(error)) {
+        return false;
+    }
+    // Every candidate is a separate build, so the first (compiling) run is enough as a warmup
+    context.settings.warmupIterations = 1;
+
+    if (space.localSizes.empty()) {
+        generateLocalSizes();
+    } else {
+        localSizes = space.localSizes;
+    }
+    radix.clear();
+    size_t candidateCount = 1;
+    for (auto& parameter : space.parameters) {
+        radix.push_back(parameter.values.size());
+        candidateCount *= parameter.values.size();
+    }
+    radix.push_back(localSizes.size());
+    candidateCount *= localSizes.size();
+    if (localSizes.empty()) {
+        error = "No work group sizes to try";
+        return false;
+    }
+
+    // Buffers are filled with random floats, which are valid inputs for most kernels and keep denormals out of the timings
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (auto& argument : space.arguments) {
+        cl_mem buffer = nullptr;
+        if (argument.type == TuningSpace::Argument::Type::Buffer) {
+            if (argument.size.size > context.maxBufferSize()) {
+                error = "Buffer size exceeds the maximum buffer size of " + Benchmark::sizeString(context.maxBufferSize());
+                return false;
+            }
+            std::vector<float> data((argument.size.size + sizeof(float) - 1) / sizeof(float));
+            for (auto& value : data) {
+                value = distribution(generator);
+            }
+            buffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, size_t(argument.size.size), data.data(), error);
+            if (!buffer) {
+                return false;
+            }
+        }
+        buffers.push_back(buffer);
+    }
+
+    const bool grid = (space.search == "grid") || ((space.search == "auto") && (candidateCount <= maxGridCandidates));
+    qInfo() << "Tuning" << space.kernelName << "with" << (grid ? "grid" : "heuristic") << "search over" << candidateCount << "candidates";
+    const std::vector<size_t> best = grid ? gridSearch() : heuristicSearch();
+    if (best.empty()) {
+        error = "No valid configuration found for kernel " + space.kernelName;
+        if (!lastError.isEmpty()) {
+            error += ", last error: " + lastError;
+        }
+        return false;
+    }
+    const double bestTime = candidateTimes[best];
+
+    quint32 invalid = 0;
+    std::vector<std::pair<double, std::vector<size_t>>> ranking;
+    for (auto& candidateTime : candidateTimes) {
+        if (candidateTime.second < 0.0) {
+            invalid++;
+        } else {
+            ranking.push_back({ candidateTime.second, candidateTime.first });
+        }
+    }
+    std::sort(ranking.begin(), ranking.end());
+
+    auto timeString = [](double time) {
+        return QString::number(time / 1e6, 'f', 3) + " ms";
+    };
+    QTextStream stream(&result);
+    stream << context.device.identifier.name << "\n";
+    stream << "Kernel " << space.kernelName << " (" << QFileInfo(space.sourceFile).fileName() << "), " << (grid ? "grid" : "heuristic") << " search\n";
+    stream << "Evaluated " << candidateTimes.size() << " of " << candidateCount << " candidates, " << invalid << " invalid (" << failedBuilds << " failed builds)\n";
+    stream << "Best configuration: " << describe(best) << "\n";
+    stream << "    Kernel time: " << timeString(bestTime) << "\n";
+    // Work group sizes chosen by the implementation are only comparable if neither the source nor the arguments depend on them
+    bool localSizeDependent = space.defineLocalSize;
+    for (auto& argument : space.arguments) {
+        for (auto& name : argument.size.multiplyBy + argument.size.divideBy) {
+            localSizeDependent |= name.startsWith("LOCAL_SIZE_");
+        }
+    }
+    if (!localSizeDependent) {
+        const double driverTime = evaluate(best, true);
+        if (driverTime > 0.0) {
+            stream << "    Implementation chosen work group size: " << timeString(driverTime) << QString(" (%1x)").arg(driverTime / bestTime, 0, 'f', 2) << "\n";
+        }
+    }
+    stream << "Fastest candidates:\n";
+    for (size_t i = 0; i < std::min(ranking.size(), size_t(5)); i++) {
+        stream << "    " << timeString(ranking[i].first) << ": " << describe(ranking[i].second) << "\n";
+    }
+
+    QJsonObject entry;
+    entry["kernel"] = space.kernelName;
+    entry["source"] = QFileInfo(space.sourceFile).fileName();
+    entry["sourceHash"] = QString(QCryptographicHash::hash(space.source.toUtf8(), QCryptographicHash::Sha1).toHex());
+    entry["options"] = space.options;
+    QJsonArray jsonProblemSize;
+    QJsonArray jsonGlobalSize;
+    QJsonArray jsonLocalSize;
+    for (size_t i = 0; i < space.globalSize.size(); i++) {
+        jsonProblemSize.append(double(space.globalSize[i].size));
+        jsonGlobalSize.append(double(scaledSize(space.globalSize[i], best)));
+        jsonLocalSize.append(double(localSizes[best.back()][i]));
+    }
+    entry["problemSize"] = jsonProblemSize;
+    entry["globalSize"] = jsonGlobalSize;
+    entry["localSize"] = jsonLocalSize;
+    QJsonObject jsonParameters;
+    for (size_t i = 0; i < space.parameters.size(); i++) {
+        jsonParameters[space.parameters[i].name] = double(space.parameters[i].values[best[i]]);
+    }
+    entry["parameters"] = jsonParameters;
+    entry["buildOptions"] = buildOptions(best);
+    entry["time"] = bestTime;
+    entry["search"] = grid ? "grid" : "heuristic";
+    entry["candidates"] = int(candidateTimes.size());
+    entry["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    TuningDatabase database;
+    if (!database.load(error)) {
+        return false;
+    }
+    database.update(context.device, entry);
+    if (!database.store(error)) {
+        return false;
+    }
+    stream << "Stored in " << database.fileName() << "\n";
+    return true;
+}
+
+TuningDatabase::TuningDatabase()
+{
+    path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/tuning.json";
+}
+
+QString TuningDatabase::fileName()
+{
+    return path;
+}
+
+bool TuningDatabase::load(QString& error)
+{
+    root = QJsonObject();
+    QFile file(path);
+    if (!file.exists()) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Could not open tuning database " + path;
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if ((parseError.error != QJsonParseError::NoError) || !document.isObject()) {
+        error = "Could not parse tuning database " + path + ": " + parseError.errorString();
+        return false;
+    }
+    root = document.object();
+    return true;
+}
+
+bool TuningDatabase::store(QString& error)
+{
+    root["version"] = 1;
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        error = "Could not create directory for tuning database " + path;
+        return false;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = "Could not write tuning database " + path;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+void TuningDatabase::update(DeviceInfo& device, const QJsonObject& entry)
+{
+    QJsonArray jsonDevices = root["devices"].toArray();
+    qsizetype deviceIndex = -1;
+    for (qsizetype i = 0; i < jsonDevices.size(); i++) {
+        const QJsonObject jsonDevice = jsonDevices[i].toObject();
+        if ((jsonDevice["name"].toString() == device.identifier.name) && (jsonDevice["deviceVersion"].toString() == device.identifier.deviceVersion) && (jsonDevice["driverVersion"].toString() == device.identifier.driverVersion)) {
+            deviceIndex = i;
+            break;
+        }
+    }
+    QJsonObject jsonDevice;
+    if (deviceIndex >= 0) {
+        jsonDevice = jsonDevices[deviceIndex].toObject();
+    } else {
+        jsonDevice["name"] = device.identifier.name;
+        jsonDevice["deviceVersion"] = device.identifier.deviceVersion;
+        jsonDevice["driverVersion"] = device.identifier.driverVersion;
+    }
+    QJsonArray jsonKernels;
+    for (const QJsonValue& jsonKernel : jsonDevice["kernels"].toArray()) {
+        const QJsonObject jsonEntry = jsonKernel.toObject();
+        if ((jsonEntry.value("kernel") != entry.value("kernel")) || (jsonEntry.value("problemSize") != entry.value("problemSize"))) {
+            jsonKernels.append(jsonKernel);
+        }
+    }
+    jsonKernels.append(entry);
+    jsonDevice["kernels"] = jsonKernels;
+    if (deviceIndex >= 0) {
+        jsonDevices[deviceIndex] = jsonDevice;
+    } else {
+        jsonDevices.append(jsonDevice);
+    }
+    root["devices"] = jsonDevices;
+}
+
+bool TuningDatabase::exportTo(const QString& fileName, QString& error)
+{
+    if (!load(error)) {
+        return false;
+    }
+    if (root["devices"].toArray().isEmpty()) {
+        error = "Tuning database " + path + " is empty";
+        return false;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = "Could not write " + fileName;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
@@ -0,0 +1,122 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include "benchmark.h"
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <vector>
+#include <map>
+
+// Kernel and parameter space to be tuned, read from a JSON file (see docs/commandline_arguments.md for the format)
+struct TuningSpace
+{
+    // Size that is multiplied and divided by the values of tuning parameters (or LOCAL_SIZE_X/Y/Z) of a candidate
+    struct ScaledSize
+    {
+        quint64 size = 0;
+        QStringList multiplyBy;
+        QStringList divideBy;
+    };
+    // Tuning parameters are passed to the kernel source as defines
+    struct Parameter
+    {
+        QString name;
+        std::vector<qint64> values;
+    };
+    struct Argument
+    {
+        enum class Type { Buffer, Local, Int, UInt, Float };
+        Type type;
+        ScaledSize size;
+        double value = 0.0;
+    };
+    QString fileName;
+    QString sourceFile;
+    QString source;
+    QString kernelName;
+    QString options;
+    // auto, grid or heuristic
+    QString search;
+    // Pass the work group size as LOCAL_SIZE_X/Y/Z defines (requires one build per work group size)
+    bool defineLocalSize = false;
+    std::vector<ScaledSize> globalSize;
+    std::vector<Parameter> parameters;
+    // Work group sizes to try, generated from the device limits if not set
+    std::vector<std::vector<size_t>> localSizes;
+    std::vector<Argument> arguments;
+    bool load(const QString& fileName, QString& error);
+};
+
+// Searches the parameter and work group size space of a kernel for the configuration with the lowest kernel time
+// A candidate holds one value index per parameter followed by the index of its work group size
+class Autotuner
+{
+private:
+    BenchmarkContext context;
+    TuningSpace space;
+    std::vector<std::vector<size_t>> localSizes;
+    // Number of values per candidate index
+    std::vector<size_t> radix;
+    std::vector<cl_mem> buffers;
+    // Kernels by build options, null if the build failed
+    std::map<QString, cl_kernel> kernels;
+    // Median kernel time of all evaluated candidates, negative for invalid ones
+    std::map<std::vector<size_t>, double> candidateTimes;
+    quint32 failedBuilds = 0;
+    QString lastError;
+    qint64 resolve(const QString& name, const std::vector<size_t>& candidate);
+    quint64 scaledSize(const TuningSpace::ScaledSize& size, const std::vector<size_t>& candidate);
+    QString buildOptions(const std::vector<size_t>& candidate);
+    QString describe(const std::vector<size_t>& candidate);
+    cl_kernel kernel(const std::vector<size_t>& candidate);
+    double evaluate(const std::vector<size_t>& candidate, bool driverLocalSize = false);
+    bool nextCandidate(std::vector<size_t>& candidate);
+    void generateLocalSizes();
+    void pruneLocalSizes();
+    std::vector<size_t> gridSearch();
+    std::vector<size_t> heuristicSearch();
+public:
+    Autotuner(DeviceInfo& device, const BenchmarkSettings& settings);
+    bool tune(const QString& spaceFile, QString& result, QString& error);
+};
+
+// Best configurations found by the autotuner, stored as JSON in the user's application data location
+// Entries are grouped per device, device version and driver version, as tuning results don't carry over to other drivers
+class TuningDatabase
+{
+private:
+    QString path;
+    QJsonObject root;
+public:
+    TuningDatabase();
+    QString fileName();
+    // A missing database is not an error, it's created with the first stored configuration
+    bool load(QString& error);
+    bool store(QString& error);
+    // Replaces the entry with the same kernel name and problem size for that device
+    void update(DeviceInfo& device, const QJsonObject& entry);
+    bool exportTo(const QString& fileName, QString& error);
+};
+
+#endif
@@ -0,0 +1,468 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmark.h"
+#include "benchmarks.h"
+#include <random>
+
+double BenchmarkTimings::min() const
+{
+    return samples.empty() ? 0.0 : *std::min_element(samples.begin(), samples.end());
+}
+
+double BenchmarkTimings::max() const
+{
+    return samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+}
+
+double BenchmarkTimings::mean() const
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    return sum / samples.size();
+}
+
+double BenchmarkTimings::median() const
+{
+    return percentile(50.0);
+}
+
+double BenchmarkTimings::percentile(double p) const
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    // Nearest rank on a sorted copy, samples are kept in submission order
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    const double rank = std::max(0.0, std::min(1.0, p / 100.0)) * (sorted.size() - 1);
+    return sorted[size_t(rank + 0.5)];
+}
+
+BenchmarkContext::BenchmarkContext(DeviceInfo& device, const BenchmarkSettings& settings) : device(device), deviceId(device.deviceId), settings(settings)
+{
+}
+
+BenchmarkContext::BenchmarkContext(DeviceInfo& device, const BenchmarkSettings& settings, cl_device_id subDevice) : device(device), deviceId(subDevice), settings(settings)
+{
+}
+
+BenchmarkContext::~BenchmarkContext()
+{
+    releaseObjects();
+    if (queue) {
+        _clReleaseCommandQueue(queue);
+    }
+    if (context) {
+        _clReleaseContext(context);
+    }
+}
+
+bool BenchmarkContext::create(QString& error)
+{
+    cl_int status = CL_SUCCESS;
+    context = _clCreateContext(nullptr, 1, &deviceId, nullptr, nullptr, &status);
+    if (status != CL_SUCCESS) {
+        context = nullptr;
+        error = "Could not create context: " + utils::errorString(status);
+        return false;
+    }
+    queue = createQueue(CL_QUEUE_PROFILING_ENABLE, error);
+    if (!queue) {
+        return false;
+    }
+    // The default queue is owned by the context itself and must survive releaseObjects()
+    queues.pop_back();
+    return true;
+}
+
+void BenchmarkContext::releaseObjects()
+{
+    if (queue) {
+        _clFinish(queue);
+    }
+    for (auto kernel : kernels) {
+        _clReleaseKernel(kernel);
+    }
+    for (auto program : programs) {
+        _clReleaseProgram(program);
+    }
+    for (auto buffer : buffers) {
+        _clReleaseMemObject(buffer);
+    }
+    for (auto commandQueue : queues) {
+        _clFinish(commandQueue);
+        _clReleaseCommandQueue(commandQueue);
+    }
+    kernels.clear();
+    programs.clear();
+    buffers.clear();
+    queues.clear();
+}
+
+QString BenchmarkContext::deviceString(cl_device_info info)
+{
+    size_t valueSize = 0;
+    if ((_clGetDeviceInfo(deviceId, info, 0, nullptr, &valueSize) != CL_SUCCESS) || (valueSize == 0)) {
+        return QString();
+    }
+    std::vector<char> value(valueSize + 1, 0);
+    _clGetDeviceInfo(deviceId, info, valueSize, value.data(), nullptr);
+    return QString::fromUtf8(value.data()).trimmed();
+}
+
+cl_ulong BenchmarkContext::maxBufferSize()
+{
+    const cl_ulong maxAllocation = deviceValue<cl_ulong>(CL_DEVICE_MAX_MEM_ALLOC_SIZE);
+    const cl_ulong globalMemory = deviceValue<cl_ulong>(CL_DEVICE_GLOBAL_MEM_SIZE);
+    // Benchmarks usually need several buffers at once, and CPU implementations report the whole system memory
+    return std::min(maxAllocation, globalMemory / 8);
+}
+
+cl_command_queue BenchmarkContext::createQueue(cl_command_queue_properties properties, QString& error)
+{
+    cl_int status = CL_INVALID_OPERATION;
+    cl_command_queue commandQueue = nullptr;
+    // clCreateCommandQueue is deprecated since OpenCL 2.0, but the only option for OpenCL 1.x implementations
+    if ((device.clVersionMajor >= 2) && (_clCreateCommandQueueWithProperties)) {
+        const cl_queue_properties queueProperties[] = { CL_QUEUE_PROPERTIES, properties, 0 };
+        commandQueue = _clCreateCommandQueueWithProperties(context, deviceId, queueProperties, &status);
+    }
+    if ((status != CL_SUCCESS) && (_clCreateCommandQueue)) {
+        commandQueue = _clCreateCommandQueue(context, deviceId, properties, &status);
+    }
+    if (status != CL_SUCCESS) {
+        error = "Could not create command queue: " + utils::errorString(status);
+        return nullptr;
+    }
+    queues.push_back(commandQueue);
+    return commandQueue;
+}
+
+cl_command_queue BenchmarkContext::createFamilyQueue(cl_uint family, cl_uint index, cl_command_queue_properties properties, QString& error)
+{
+    if (!_clCreateCommandQueueWithProperties) {
+        error = "clCreateCommandQueueWithProperties is not available";
+        return nullptr;
+    }
+    const cl_queue_properties queueProperties[] = { CL_QUEUE_PROPERTIES, properties, CL_QUEUE_FAMILY_INTEL, family, CL_QUEUE_INDEX_INTEL, index, 0 };
+    cl_int status = CL_SUCCESS;
+    cl_command_queue commandQueue = _clCreateCommandQueueWithProperties(context, deviceId, queueProperties, &status);
+    if (status != CL_SUCCESS) {
+        error = QString("Could not create command queue %1 of queue family %2: ").arg(index).arg(family) + utils::errorString(status);
+        return nullptr;
+    }
+    queues.push_back(commandQueue);
+    return commandQueue;
+}
+
+cl_command_queue BenchmarkContext::createDeviceQueue(cl_uint size, QString& error)
+{
+    if (!_clCreateCommandQueueWithProperties) {
+        error = "clCreateCommandQueueWithProperties is not available";
+        return nullptr;
+    }
+    const cl_queue_properties queueProperties[] = { CL_QUEUE_PROPERTIES, CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE | CL_QUEUE_ON_DEVICE, CL_QUEUE_SIZE, size, 0 };
+    cl_int status = CL_SUCCESS;
+    cl_command_queue commandQueue = _clCreateCommandQueueWithProperties(context, deviceId, queueProperties, &status);
+    if (status != CL_SUCCESS) {
+        error = QString("Could not create device queue of %1 bytes: ").arg(size) + utils::errorString(status);
+        return nullptr;
+    }
+    queues.push_back(commandQueue);
+    return commandQueue;
+}
+
+void BenchmarkContext::releaseQueue(cl_command_queue commandQueue)
+{
+    auto it = std::find(queues.begin(), queues.end(), commandQueue);
+    if (it != queues.end()) {
+        _clReleaseCommandQueue(commandQueue);
+        queues.erase(it);
+    }
+}
+
+cl_mem BenchmarkContext::createBuffer(cl_mem_flags flags, size_t size, void* hostPtr, QString& error)
+{
+    cl_int status = CL_SUCCESS;
+    cl_mem buffer = _clCreateBuffer(context, flags, size, hostPtr, &status);
+    if (status != CL_SUCCESS) {
+        error = QString("Could not create buffer of %1 bytes: ").arg(size) + utils::errorString(status);
+        return nullptr;
+    }
+    buffers.push_back(buffer);
+    return buffer;
+}
+
+cl_mem BenchmarkContext::createImage2D(cl_mem_flags flags, const cl_image_format& format, size_t width, size_t height, QString& error)
+{
+    cl_int status = CL_INVALID_OPERATION;
+    cl_mem image = nullptr;
+    // clCreateImage2D is deprecated since OpenCL 1.2, but the only option for OpenCL 1.0 and 1.1 implementations
+    if (((device.clVersionMajor > 1) || (device.clVersionMinor >= 2)) && (_clCreateImage)) {
+        cl_image_desc imageDesc{};
+        imageDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        imageDesc.image_width = width;
+        imageDesc.image_height = height;
+        image = _clCreateImage(context, flags, &format, &imageDesc, nullptr, &status);
+    } else if (_clCreateImage2D) {
+        image = _clCreateImage2D(context, flags, &format, width, height, 0, nullptr, &status);
+    }
+    if (status != CL_SUCCESS) {
+        error = QString("Could not create %1x%2 image: ").arg(width).arg(height) + utils::errorString(status);
+        return nullptr;
+    }
+    buffers.push_back(image);
+    return image;
+}
+
+void BenchmarkContext::releaseBuffer(cl_mem buffer)
+{
+    auto it = std::find(buffers.begin(), buffers.end(), buffer);
+    if (it != buffers.end()) {
+        _clReleaseMemObject(buffer);
+        buffers.erase(it);
+    }
+}
+
+cl_program BenchmarkContext::buildProgram(const QString& source, const QString& options, QString& error)
+{
+    const QByteArray sourceData = source.toUtf8();
+    const char* sourcePtr = sourceData.constData();
+    const size_t sourceLength = sourceData.size();
+    cl_int status = CL_SUCCESS;
+    cl_program program = _clCreateProgramWithSource(context, 1, &sourcePtr, &sourceLength, &status);
+    if (status != CL_SUCCESS) {
+        error = "Could not create program: " + utils::errorString(status);
+        return nullptr;
+    }
+    programs.push_back(program);
+    const QByteArray optionsData = options.toUtf8();
+    status = _clBuildProgram(program, 1, &deviceId, optionsData.constData(), nullptr, nullptr);
+    if (status != CL_SUCCESS) {
+        size_t logSize = 0;
+        _clGetProgramBuildInfo(program, deviceId, CL_PROGRAM_BUILD_LOG, 0, nullptr, &logSize);
+        std::vector<char> buildLog(logSize + 1, 0);
+        _clGetProgramBuildInfo(program, deviceId, CL_PROGRAM_BUILD_LOG, logSize, buildLog.data(), nullptr);
+        qWarning() << "Program build log:" << buildLog.data();
+        error = "Could not build program: " + utils::errorString(status) + "\n" + QString::fromUtf8(buildLog.data()).trimmed();
+        return nullptr;
+    }
+    return program;
+}
+
+cl_kernel BenchmarkContext::createKernel(cl_program program, const char* name, QString& error)
+{
+    cl_int status = CL_SUCCESS;
+    cl_kernel kernel = _clCreateKernel(program, name, &status);
+    if (status != CL_SUCCESS) {
+        error = QString("Could not create kernel %1: ").arg(name) + utils::errorString(status);
+        return nullptr;
+    }
+    kernels.push_back(kernel);
+    return kernel;
+}
+
+double BenchmarkContext::eventDuration(cl_event event)
+{
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr);
+    _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr);
+    return (end > start) ? double(end - start) : 0.0;
+}
+
+bool BenchmarkContext::time(const std::function<cl_int(cl_event*)>& enqueue, BenchmarkTimings& timings, QString& error)
+{
+    timings.samples.clear();
+    const uint32_t runs = settings.warmupIterations + settings.iterations;
+    for (uint32_t i = 0; i < runs; i++) {
+        cl_event event = nullptr;
+        cl_int status = enqueue(&event);
+        if (status != CL_SUCCESS) {
+            error = "Could not enqueue command: " + utils::errorString(status);
+            return false;
+        }
+        // Each run is waited for, so measured runs don't overlap with each other
+        status = _clWaitForEvents(1, &event);
+        if ((status == CL_SUCCESS) && (i >= settings.warmupIterations)) {
+            timings.samples.push_back(eventDuration(event));
+        }
+        _clReleaseEvent(event);
+        if (status != CL_SUCCESS) {
+            error = "Command did not complete: " + utils::errorString(status);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BenchmarkContext::timeKernel(cl_kernel kernel, cl_uint dimensions, const size_t* globalSize, const size_t* localSize, BenchmarkTimings& timings, QString& error)
+{
+    return time([&](cl_event* event) {
+        return _clEnqueueNDRangeKernel(queue, kernel, dimensions, nullptr, globalSize, localSize, 0, nullptr, event);
+    }, timings, error);
+}
+
+bool BenchmarkContext::timeHost(const std::function<cl_int()>& operation, BenchmarkTimings& timings, QString& error)
+{
+    timings.samples.clear();
+    const uint32_t runs = settings.warmupIterations + settings.iterations;
+    for (uint32_t i = 0; i < runs; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        const cl_int status = operation();
+        const auto end = std::chrono::steady_clock::now();
+        if (status != CL_SUCCESS) {
+            error = "Operation failed: " + utils::errorString(status);
+            return false;
+        }
+        if (i >= settings.warmupIterations) {
+            timings.samples.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+    }
+    return true;
+}
+
+bool Benchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    (void)context;
+    (void)reason;
+    return true;
+}
+
+QString Benchmark::sizeString(quint64 bytes)
+{
+    return QLocale::c().formattedDataSize(bytes, 0, QLocale::DataSizeIecFormat);
+}
+
+std::vector<cl_uint> Benchmark::randomCycle(cl_uint size)
+{
+    std::vector<cl_uint> cycle(size);
+    for (cl_uint i = 0; i < size; i++) {
+        cycle[i] = i;
+    }
+    if (size < 2) {
+        return cycle;
+    }
+    std::mt19937 generator(1);
+    for (cl_uint i = size - 1; i > 0; i--) {
+        std::uniform_int_distribution<cl_uint> distribution(0, i - 1);
+        std::swap(cycle[i], cycle[distribution(generator)]);
+    }
+    return cycle;
+}
+
+// Runs a single iteration of the kernel per step, so calibration stays short even for slow devices
+bool Benchmark::calibrateIterations(BenchmarkContext& context, cl_kernel kernel, cl_uint argumentIndex, const size_t& globalSize, const size_t& localSize, cl_int& iterations, QString& error)
+{
+    const BenchmarkSettings settings = context.settings;
+    context.settings.warmupIterations = 1;
+    context.settings.iterations = 1;
+    iterations = 16;
+    bool success = true;
+    while (success) {
+        _clSetKernelArg(kernel, argumentIndex, sizeof(cl_int), &iterations);
+        BenchmarkTimings timings;
+        success = context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error);
+        if (!success || (timings.median() >= 10e6) || (iterations >= 65536)) {
+            break;
+        }
+        iterations *= 4;
+    }
+    context.settings = settings;
+    return success;
+}
+
+BenchmarkRunner::BenchmarkRunner()
+{
+    benchmarks.emplace_back(new VectorAddBenchmark());
+    benchmarks.emplace_back(new BandwidthBenchmark());
+    benchmarks.emplace_back(new TransferBenchmark());
+    benchmarks.emplace_back(new LatencyBenchmark());
+    benchmarks.emplace_back(new ComputeBenchmark());
+    benchmarks.emplace_back(new LocalMemoryBenchmark());
+    benchmarks.emplace_back(new AtomicsBenchmark());
+    benchmarks.emplace_back(new CacheBenchmark());
+    benchmarks.emplace_back(new BuildBenchmark());
+    benchmarks.emplace_back(new ImageBenchmark());
+    benchmarks.emplace_back(new SvmBenchmark());
+    benchmarks.emplace_back(new SubGroupBenchmark());
+    benchmarks.emplace_back(new QueuesBenchmark());
+    benchmarks.emplace_back(new DotProductBenchmark());
+    benchmarks.emplace_back(new CommandBufferBenchmark());
+    benchmarks.emplace_back(new DeviceEnqueueBenchmark());
+    benchmarks.emplace_back(new PartitionBenchmark());
+    benchmarks.emplace_back(new RooflineBenchmark());
+    benchmarks.emplace_back(new TimerBenchmark());
+}
+
+QStringList BenchmarkRunner::ids()
+{
+    QStringList list;
+    for (auto& benchmark : benchmarks) {
+        list.append(benchmark->id());
+    }
+    return list;
+}
+
+BenchmarkRunResults BenchmarkRunner::run(DeviceInfo& device, const QStringList& selection, const BenchmarkSettings& settings)
+{
+    qInfo() << "Running benchmarks for device" << device.identifier.name;
+    BenchmarkContext context(device, settings);
+    QString error;
+    if (!context.create(error)) {
+        qWarning() << error;
+        BenchmarkResult result;
+        result.name = "Benchmarks";
+        result.message = error;
+        context.results.benchmarks.push_back(result);
+        return context.results;
+    }
+    for (auto& benchmark : benchmarks) {
+        if (!selection.isEmpty() && !selection.contains(benchmark->id(), Qt::CaseInsensitive)) {
+            continue;
+        }
+        BenchmarkResult result;
+        result.name = benchmark->name();
+        QString reason;
+        if (!benchmark->supported(context, reason)) {
+            qInfo() << "Skipping benchmark" << result.name << ":" << reason;
+            result.message = "Not supported: " + reason;
+            context.results.benchmarks.push_back(result);
+            continue;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        error.clear();
+        if (!benchmark->run(context, result, error)) {
+            qWarning() << "Benchmark" << result.name << "failed:" << error;
+            result.message = error;
+        }
+        context.releaseObjects();
+        qInfo() << "Benchmark" << result.name << "finished in" << timer.elapsed() << "ms";
+        context.results.benchmarks.push_back(result);
+    }
+    return context.results;
+}
@@ -0,0 +1,149 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "CL/cl.h"
+#include "deviceinfo.h"
+#include "openclfunctions.h"
+#include "openclutils.h"
+#include <QString>
+#include <QStringList>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QLocale>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+struct BenchmarkSettings
+{
+    // Runs that are executed but not measured, e.g. to trigger lazy allocations and kernel compilation
+    uint32_t warmupIterations = 3;
+    uint32_t iterations = 10;
+};
+
+// Device side execution times in nanoseconds, taken from profiling events
+struct BenchmarkTimings
+{
+    std::vector<double> samples;
+    double min() const;
+    double max() const;
+    double mean() const;
+    double median() const;
+    double percentile(double p) const;
+};
+
+// Everything measured by a run of the benchmarks for one device
+// Benchmarks run on a worker thread in the GUI, so device level results are collected here and only assigned to the device once the run has finished
+struct BenchmarkRunResults
+{
+    std::vector<BenchmarkResult> benchmarks;
+    // Only filled by the partition benchmark
+    std::vector<DevicePartition> partitions;
+    // Only filled by the roofline benchmark
+    RooflineModel roofline;
+    // Only filled by the timer calibration benchmark
+    TimerCalibration timerCalibration;
+};
+
+// OpenCL context and profiling queue shared by all benchmarks run for a single device
+// All objects created through this class are owned by it and released after each benchmark
+class BenchmarkContext
+{
+private:
+    std::vector<cl_mem> buffers;
+    std::vector<cl_kernel> kernels;
+    std::vector<cl_program> programs;
+    std::vector<cl_command_queue> queues;
+public:
+    DeviceInfo& device;
+    // Device the context and all objects are created for, either the device itself or one of its sub-devices
+    cl_device_id deviceId;
+    BenchmarkSettings settings;
+    BenchmarkRunResults results;
+    cl_context context = nullptr;
+    // In-order queue with profiling enabled
+    cl_command_queue queue = nullptr;
+    BenchmarkContext(DeviceInfo& device, const BenchmarkSettings& settings);
+    BenchmarkContext(DeviceInfo& device, const BenchmarkSettings& settings, cl_device_id subDevice);
+    ~BenchmarkContext();
+    bool create(QString& error);
+    void releaseObjects();
+    template<typename T>
+    T deviceValue(cl_device_info info)
+    {
+        T value{};
+        _clGetDeviceInfo(deviceId, info, sizeof(T), &value, nullptr);
+        return value;
+    }
+    QString deviceString(cl_device_info info);
+    // Largest buffer size that can safely be allocated (limited to a fraction of the global memory)
+    cl_ulong maxBufferSize();
+    cl_command_queue createQueue(cl_command_queue_properties properties, QString& error);
+    // Queue with the given index of a cl_intel_command_queue_families queue family
+    cl_command_queue createFamilyQueue(cl_uint family, cl_uint index, cl_command_queue_properties properties, QString& error);
+    // Out-of-order on-device queue of the given size in bytes for device side enqueue, passed to kernels as queue_t argument
+    cl_command_queue createDeviceQueue(cl_uint size, QString& error);
+    void releaseQueue(cl_command_queue commandQueue);
+    cl_mem createBuffer(cl_mem_flags flags, size_t size, void* hostPtr, QString& error);
+    cl_mem createImage2D(cl_mem_flags flags, const cl_image_format& format, size_t width, size_t height, QString& error);
+    void releaseBuffer(cl_mem buffer);
+    cl_program buildProgram(const QString& source, const QString& options, QString& error);
+    cl_kernel createKernel(cl_program program, const char* name, QString& error);
+    static double eventDuration(cl_event event);
+    // Runs the enqueue function for all warmup and measured iterations, the function needs to return the event of the command to be timed
+    bool time(const std::function<cl_int(cl_event*)>& enqueue, BenchmarkTimings& timings, QString& error);
+    bool timeKernel(cl_kernel kernel, cl_uint dimensions, const size_t* globalSize, const size_t* localSize, BenchmarkTimings& timings, QString& error);
+    // Measures the host side wall clock time of a blocking operation, for costs that profiling events don't cover (e.g. map and copy)
+    bool timeHost(const std::function<cl_int()>& operation, BenchmarkTimings& timings, QString& error);
+};
+
+class Benchmark
+{
+public:
+    virtual ~Benchmark() = default;
+    // Short name used to select the benchmark from the command line
+    virtual QString id() = 0;
+    virtual QString name() = 0;
+    virtual bool supported(BenchmarkContext& context, QString& reason);
+    virtual bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) = 0;
+    static QString sizeString(quint64 bytes);
+    // Random cyclic permutation (Sattolo's algorithm), following it from any element visits all elements
+    static std::vector<cl_uint> randomCycle(cl_uint size);
+    // Finds an iteration count (passed as the kernel argument with the given index) that results in kernel runs of at least 10 ms
+    static bool calibrateIterations(BenchmarkContext& context, cl_kernel kernel, cl_uint argumentIndex, const size_t& globalSize, const size_t& localSize, cl_int& iterations, QString& error);
+};
+
+class BenchmarkRunner
+{
+private:
+    std::vector<std::unique_ptr<Benchmark>> benchmarks;
+public:
+    BenchmarkRunner();
+    QStringList ids();
+    // Runs all benchmarks or only those with ids contained in the selection
+    BenchmarkRunResults run(DeviceInfo& device, const QStringList& selection, const BenchmarkSettings& settings);
+};
+
+#endif
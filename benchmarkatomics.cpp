@@ -0,0 +1,272 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// OpenCL C 2.0+ atomics with explicit memory order and scope, ORDER and SCOPE are passed as build options
+// Each work item uses the counter selected by its id modulo the counter count, which controls the contention
+static const char* atomicsSource = R"(
+__kernel void globalAdd(__global atomic_int* counters, const uint counterCount, const int iterations)
+{
+    __global atomic_int* counter = counters + (get_global_id(0) % counterCount);
+    for (int i = 0; i < iterations; i++) {
+        atomic_fetch_add_explicit(counter, 1, ORDER, SCOPE);
+    }
+}
+
+__kernel void globalCas(__global atomic_int* counters, const uint counterCount, const int iterations)
+{
+    __global atomic_int* counter = counters + (get_global_id(0) % counterCount);
+    int expected = atomic_load_explicit(counter, memory_order_relaxed, SCOPE);
+    for (int i = 0; i < iterations; i++) {
+        // A failed exchange updates expected with the current value, both outcomes count as one operation
+        if (atomic_compare_exchange_strong_explicit(counter, &expected, expected + 1, ORDER, memory_order_relaxed, SCOPE)) {
+            expected++;
+        }
+    }
+}
+
+#ifdef LOCAL_ATOMICS
+__kernel void localAdd(__global int* output, const uint counterCount, const int iterations)
+{
+    __local atomic_int counters[256];
+    const uint lid = get_local_id(0);
+    atomic_store_explicit(&counters[lid & 255], 0, memory_order_relaxed, memory_scope_work_group);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    __local atomic_int* counter = counters + (lid % counterCount);
+    for (int i = 0; i < iterations; i++) {
+        atomic_fetch_add_explicit(counter, 1, ORDER, memory_scope_work_group);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid == 0) {
+        output[get_group_id(0)] = atomic_load_explicit(&counters[0], memory_order_relaxed, memory_scope_work_group);
+    }
+}
+
+__kernel void localCas(__global int* output, const uint counterCount, const int iterations)
+{
+    __local atomic_int counters[256];
+    const uint lid = get_local_id(0);
+    atomic_store_explicit(&counters[lid & 255], 0, memory_order_relaxed, memory_scope_work_group);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    __local atomic_int* counter = counters + (lid % counterCount);
+    int expected = 0;
+    for (int i = 0; i < iterations; i++) {
+        if (atomic_compare_exchange_strong_explicit(counter, &expected, expected + 1, ORDER, memory_order_relaxed, memory_scope_work_group)) {
+            expected++;
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid == 0) {
+        output[get_group_id(0)] = atomic_load_explicit(&counters[0], memory_order_relaxed, memory_scope_work_group);
+    }
+}
+#endif
+)";
+
+// OpenCL 1.x atomic functions, these are relaxed with device scope
+static const char* legacyAtomicsSource = R"(
+__kernel void globalAdd(__global int* counters, const uint counterCount, const int iterations)
+{
+    __global int* counter = counters + (get_global_id(0) % counterCount);
+    for (int i = 0; i < iterations; i++) {
+        atomic_add(counter, 1);
+    }
+}
+
+__kernel void globalCas(__global int* counters, const uint counterCount, const int iterations)
+{
+    __global int* counter = counters + (get_global_id(0) % counterCount);
+    int expected = *counter;
+    for (int i = 0; i < iterations; i++) {
+        const int old = atomic_cmpxchg(counter, expected, expected + 1);
+        expected = (old == expected) ? expected + 1 : old;
+    }
+}
+
+__kernel void localAdd(__global int* output, const uint counterCount, const int iterations)
+{
+    __local int counters[256];
+    const uint lid = get_local_id(0);
+    counters[lid & 255] = 0;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    __local int* counter = counters + (lid % counterCount);
+    for (int i = 0; i < iterations; i++) {
+        atomic_add(counter, 1);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid == 0) {
+        output[get_group_id(0)] = counters[0];
+    }
+}
+
+__kernel void localCas(__global int* output, const uint counterCount, const int iterations)
+{
+    __local int counters[256];
+    const uint lid = get_local_id(0);
+    counters[lid & 255] = 0;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    __local int* counter = counters + (lid % counterCount);
+    int expected = 0;
+    for (int i = 0; i < iterations; i++) {
+        const int old = atomic_cmpxchg(counter, expected, expected + 1);
+        expected = (old == expected) ? expected + 1 : old;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid == 0) {
+        output[get_group_id(0)] = counters[0];
+    }
+}
+)";
+
+struct AtomicOrder
+{
+    cl_device_atomic_capabilities capability;
+    const char* name;
+    const char* define;
+};
+
+struct AtomicScope
+{
+    cl_device_atomic_capabilities capability;
+    const char* name;
+    const char* define;
+};
+
+static const AtomicOrder atomicOrders[] = {
+    { CL_DEVICE_ATOMIC_ORDER_RELAXED, "relaxed", "memory_order_relaxed" },
+    { CL_DEVICE_ATOMIC_ORDER_ACQ_REL, "acq_rel", "memory_order_acq_rel" },
+    { CL_DEVICE_ATOMIC_ORDER_SEQ_CST, "seq_cst", "memory_order_seq_cst" },
+};
+
+// Work item scope is left out, as there is nothing to contend with
+static const AtomicScope atomicScopes[] = {
+    { CL_DEVICE_ATOMIC_SCOPE_WORK_GROUP, "work_group", "memory_scope_work_group" },
+    { CL_DEVICE_ATOMIC_SCOPE_DEVICE, "device", "memory_scope_device" },
+    { CL_DEVICE_ATOMIC_SCOPE_ALL_DEVICES, "all_devices", "memory_scope_all_devices" },
+};
+
+struct Contention
+{
+    const char* name;
+    // Number of counters shared by all work items (global) or by the work items of a group (local), zero for one counter per work item
+    cl_uint counters;
+};
+
+static const Contention contentionLevels[] = {
+    { "low contention", 0 },
+    { "medium contention", 16 },
+    { "full contention", 1 },
+};
+
+bool AtomicsBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // Atomic capabilities are only reported by OpenCL 3.0 devices, older ones have implicit capabilities
+    const bool c11Atomics = (context.device.clVersionMajor >= 2);
+    cl_device_atomic_capabilities capabilities = CL_DEVICE_ATOMIC_ORDER_RELAXED | CL_DEVICE_ATOMIC_SCOPE_DEVICE;
+    QString languageVersion;
+    if (context.device.clVersionMajor >= 3) {
+        capabilities = context.deviceValue<cl_device_atomic_capabilities>(CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES);
+        languageVersion = "-cl-std=CL3.0";
+    } else if (context.device.clVersionMajor == 2) {
+        capabilities = CL_DEVICE_ATOMIC_ORDER_RELAXED | CL_DEVICE_ATOMIC_ORDER_ACQ_REL | CL_DEVICE_ATOMIC_ORDER_SEQ_CST | CL_DEVICE_ATOMIC_SCOPE_WORK_GROUP | CL_DEVICE_ATOMIC_SCOPE_DEVICE;
+        languageVersion = "-cl-std=CL2.0";
+    }
+
+    const cl_uint computeUnits = std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+    size_t localSize = std::min(context.deviceValue<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE), size_t(256));
+    // Power of two work group size, at most the 256 counters of the local kernels
+    while (localSize & (localSize - 1)) {
+        localSize &= localSize - 1;
+    }
+    const size_t globalSize = localSize * computeUnits * 4;
+    const cl_int iterations = 64;
+
+    std::vector<cl_int> zeros(globalSize, 0);
+    cl_mem counterBuffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, globalSize * sizeof(cl_int), zeros.data(), error);
+    if (!counterBuffer) {
+        return false;
+    }
+
+    QStringList failedCombinations;
+    for (auto& order : atomicOrders) {
+        for (auto& scope : atomicScopes) {
+            if (!(capabilities & order.capability) || !(capabilities & scope.capability)) {
+                continue;
+            }
+            // Local atomics only make sense with work group scope, so they're only run once per order
+            const bool localAtomics = (scope.capability == CL_DEVICE_ATOMIC_SCOPE_WORK_GROUP) || !c11Atomics;
+            const QString combination = c11Atomics ? QString("%1, %2").arg(order.name).arg(scope.name) : QString("legacy");
+            cl_program program = nullptr;
+            if (c11Atomics) {
+                QString options = QString("%1 -DORDER=%2 -DSCOPE=%3").arg(languageVersion).arg(order.define).arg(scope.define);
+                if (localAtomics) {
+                    options += " -DLOCAL_ATOMICS";
+                }
+                program = context.buildProgram(atomicsSource, options, error);
+            } else {
+                program = context.buildProgram(legacyAtomicsSource, "", error);
+            }
+            if (!program) {
+                // Advertised but not supported by the compiler, keep going with the other combinations
+                qWarning() << "Could not build atomics program for" << combination << ":" << error;
+                failedCombinations.append(combination);
+                continue;
+            }
+
+            std::vector<std::pair<QString, const char*>> kernelNames = { { "Global add", "globalAdd" }, { "Global compare exchange", "globalCas" } };
+            if (localAtomics) {
+                kernelNames.push_back({ "Local add", "localAdd" });
+                kernelNames.push_back({ "Local compare exchange", "localCas" });
+            }
+            for (auto& kernelName : kernelNames) {
+                cl_kernel kernel = context.createKernel(program, kernelName.second, error);
+                if (!kernel) {
+                    return false;
+                }
+                const bool local = kernelName.first.startsWith("Local");
+                _clSetKernelArg(kernel, 0, sizeof(cl_mem), &counterBuffer);
+                _clSetKernelArg(kernel, 2, sizeof(cl_int), &iterations);
+                for (auto& contention : contentionLevels) {
+                    // The global size is not a power of two for most compute unit counts, so counters are selected with a modulo instead of a mask
+                    const cl_uint counters = (contention.counters == 0) ? cl_uint(local ? localSize : globalSize) : contention.counters;
+                    _clSetKernelArg(kernel, 1, sizeof(cl_uint), &counters);
+                    BenchmarkTimings timings;
+                    if (!context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error)) {
+                        return false;
+                    }
+                    const double operations = double(globalSize) * iterations;
+                    const double throughput = (timings.median() > 0.0) ? (operations * 1000.0) / timings.median() : 0.0;
+                    result.addValue(kernelName.first, combination + ", " + contention.name, throughput, "Mops/s");
+                }
+            }
+            if (!c11Atomics) {
+                break;
+            }
+        }
+        if (!c11Atomics) {
+            break;
+        }
+    }
+    if (!failedCombinations.isEmpty()) {
+        result.message = "Advertised but could not be built: " + failedCombinations.join("; ");
+    }
+    return true;
+}
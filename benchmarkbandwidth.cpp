@@ -0,0 +1,226 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <random>
+#include <numeric>
+
+// All STREAM kernels share the same signature, so arguments can be set up once per buffer set
+// TYPE is passed as a build option to sweep vector widths
+static const char* streamSource = R"(
+__kernel void copy(__global TYPE* a, __global TYPE* b, __global TYPE* c, const float s)
+{
+    const size_t i = get_global_id(0);
+    c[i] = a[i];
+}
+
+__kernel void scale(__global TYPE* a, __global TYPE* b, __global TYPE* c, const float s)
+{
+    const size_t i = get_global_id(0);
+    b[i] = s * c[i];
+}
+
+__kernel void add(__global TYPE* a, __global TYPE* b, __global TYPE* c, const float s)
+{
+    const size_t i = get_global_id(0);
+    c[i] = a[i] + b[i];
+}
+
+__kernel void triad(__global TYPE* a, __global TYPE* b, __global TYPE* c, const float s)
+{
+    const size_t i = get_global_id(0);
+    a[i] = b[i] + s * c[i];
+}
+)";
+
+static const char* accessPatternSource = R"(
+// Neighbouring work items access elements that are stride elements apart, the index wraps around so all elements are read once
+__kernel void strided(__global const float* a, __global float* c, const uint stride, const uint shift)
+{
+    const uint i = get_global_id(0);
+    const ulong j = (ulong)i * stride;
+    const ulong mask = ((ulong)1 << shift) - 1;
+    c[i] = a[(j & mask) + (j >> shift)];
+}
+
+__kernel void gather(__global const float* a, __global const uint* index, __global float* c)
+{
+    const uint i = get_global_id(0);
+    c[i] = a[index[i]];
+}
+)";
+
+struct StreamKernel
+{
+    const char* name;
+    const char* caption;
+    // Number of buffer elements read or written per work item
+    double accesses;
+};
+
+static const StreamKernel streamKernels[] = {
+    { "copy", "Copy", 2.0 },
+    { "scale", "Scale", 2.0 },
+    { "add", "Add", 3.0 },
+    { "triad", "Triad", 3.0 }
+};
+
+static QString vectorTypeName(cl_uint width)
+{
+    return (width == 1) ? QString("float") : QString("float%1").arg(width);
+}
+
+// Times a single STREAM kernel for the given buffer size (in bytes) and returns the bandwidth in GB/s
+static bool timeStreamKernel(BenchmarkContext& context, cl_program program, const StreamKernel& streamKernel, cl_mem buffers[3], size_t bufferSize, cl_uint vectorWidth, double& bandwidth, QString& error)
+{
+    cl_kernel kernel = context.createKernel(program, streamKernel.name, error);
+    if (!kernel) {
+        return false;
+    }
+    const cl_float scalar = 3.0f;
+    for (cl_uint i = 0; i < 3; i++) {
+        _clSetKernelArg(kernel, i, sizeof(cl_mem), &buffers[i]);
+    }
+    _clSetKernelArg(kernel, 3, sizeof(cl_float), &scalar);
+    const size_t globalSize = bufferSize / (sizeof(cl_float) * vectorWidth);
+    BenchmarkTimings timings;
+    if (!context.timeKernel(kernel, 1, &globalSize, nullptr, timings, error)) {
+        return false;
+    }
+    // Bytes per nanosecond equals GB/s
+    bandwidth = (timings.median() > 0.0) ? (streamKernel.accesses * bufferSize) / timings.median() : 0.0;
+    return true;
+}
+
+bool BandwidthBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // Largest power of two buffer size below the allocation limit, capped to keep the run time reasonable
+    size_t bufferSize = size_t(256) * 1024 * 1024;
+    while ((bufferSize > context.maxBufferSize()) && (bufferSize > 1024 * 1024)) {
+        bufferSize /= 2;
+    }
+    // Buffers are initialized to avoid running into denormal or NaN slow paths on CPU implementations
+    std::vector<cl_float> hostData(bufferSize / sizeof(cl_float), 1.0f);
+    cl_mem buffers[3];
+    for (auto& buffer : buffers) {
+        buffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, bufferSize, hostData.data(), error);
+        if (!buffer) {
+            return false;
+        }
+    }
+    result.addValue("Buffer size", double(bufferSize) / (1024.0 * 1024.0), "MiB");
+
+    // The preferred vector width is used for all kernels, other widths are only swept for copy
+    cl_uint preferredWidth = context.deviceValue<cl_uint>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT);
+    if ((preferredWidth == 0) || (preferredWidth > 16) || (preferredWidth & (preferredWidth - 1))) {
+        preferredWidth = 1;
+    }
+    for (cl_uint vectorWidth : { 1u, 2u, 4u, 8u, 16u }) {
+        cl_program program = context.buildProgram(streamSource, "-DTYPE=" + vectorTypeName(vectorWidth), error);
+        if (!program) {
+            return false;
+        }
+        const QString typeName = vectorTypeName(vectorWidth) + ((vectorWidth == preferredWidth) ? " (preferred)" : "");
+        for (auto& streamKernel : streamKernels) {
+            const bool copyKernel = (&streamKernel == &streamKernels[0]);
+            if ((vectorWidth != preferredWidth) && !copyKernel) {
+                continue;
+            }
+            double bandwidth = 0.0;
+            if (!timeStreamKernel(context, program, streamKernel, buffers, bufferSize, vectorWidth, bandwidth, error)) {
+                return false;
+            }
+            if (vectorWidth == preferredWidth) {
+                result.addValue(streamKernel.caption, typeName, bandwidth, "GB/s");
+            }
+            if (copyKernel) {
+                result.addValue("Copy vector width", typeName, bandwidth, "GB/s");
+            }
+        }
+        // Buffer size sweep for triad at the preferred width, small sizes show cache effects and fixed launch costs
+        if (vectorWidth == preferredWidth) {
+            for (size_t size = 64 * 1024; size <= bufferSize; size *= 4) {
+                double bandwidth = 0.0;
+                if (!timeStreamKernel(context, program, streamKernels[3], buffers, size, vectorWidth, bandwidth, error)) {
+                    return false;
+                }
+                result.addValue("Triad buffer size", sizeString(size), bandwidth, "GB/s");
+            }
+        }
+    }
+
+    cl_program program = context.buildProgram(accessPatternSource, "", error);
+    if (!program) {
+        return false;
+    }
+    const cl_uint elementCount = cl_uint(bufferSize / sizeof(cl_float));
+    const size_t globalSize = elementCount;
+    cl_uint shift = 0;
+    while ((cl_uint(1) << shift) < elementCount) {
+        shift++;
+    }
+
+    // Strided reads, bandwidth is reported for the useful data only (one read and one write per work item)
+    cl_kernel stridedKernel = context.createKernel(program, "strided", error);
+    if (!stridedKernel) {
+        return false;
+    }
+    _clSetKernelArg(stridedKernel, 0, sizeof(cl_mem), &buffers[0]);
+    _clSetKernelArg(stridedKernel, 1, sizeof(cl_mem), &buffers[2]);
+    _clSetKernelArg(stridedKernel, 3, sizeof(cl_uint), &shift);
+    for (cl_uint stride = 1; stride <= 64; stride *= 2) {
+        _clSetKernelArg(stridedKernel, 2, sizeof(cl_uint), &stride);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(stridedKernel, 1, &globalSize, nullptr, timings, error)) {
+            return false;
+        }
+        const double bandwidth = (timings.median() > 0.0) ? (2.0 * bufferSize) / timings.median() : 0.0;
+        result.addValue("Strided read", QString("stride %1").arg(stride), bandwidth, "GB/s");
+    }
+
+    // Gathers through an index buffer, either sequential (coalesced) or a random permutation (scattered)
+    std::vector<cl_uint> indices(elementCount);
+    std::iota(indices.begin(), indices.end(), 0);
+    cl_mem indexBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bufferSize, indices.data(), error);
+    std::mt19937 generator(1);
+    std::shuffle(indices.begin(), indices.end(), generator);
+    cl_mem scatteredIndexBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bufferSize, indices.data(), error);
+    if (!indexBuffer || !scatteredIndexBuffer) {
+        return false;
+    }
+    cl_kernel gatherKernel = context.createKernel(program, "gather", error);
+    if (!gatherKernel) {
+        return false;
+    }
+    _clSetKernelArg(gatherKernel, 0, sizeof(cl_mem), &buffers[0]);
+    _clSetKernelArg(gatherKernel, 2, sizeof(cl_mem), &buffers[2]);
+    const std::pair<const char*, cl_mem> gathers[] = { { "coalesced", indexBuffer }, { "scattered", scatteredIndexBuffer } };
+    for (auto& gather : gathers) {
+        _clSetKernelArg(gatherKernel, 1, sizeof(cl_mem), &gather.second);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(gatherKernel, 1, &globalSize, nullptr, timings, error)) {
+            return false;
+        }
+        // Index read, data read and write
+        const double bandwidth = (timings.median() > 0.0) ? (3.0 * bufferSize) / timings.median() : 0.0;
+        result.addValue("Gather", gather.first, bandwidth, "GB/s");
+    }
+    return true;
+}
@@ -0,0 +1,322 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include "programcache.h"
+#include <QRegularExpression>
+#include <iterator>
+
+struct BuildKernel
+{
+    QString name;
+    const char* source;
+};
+
+// Small set of kernels representative for typical compute workloads: memory bound, local memory with barriers, tiled loops and math built-ins
+static const BuildKernel buildKernels[] = {
+    { "Vector add", R"(
+__kernel void vectorAdd(__global const float* a, __global const float* b, __global float* c)
+{
+    const size_t i = get_global_id(0);
+    c[i] = a[i] + b[i];
+}
+)" },
+    { "Reduction", R"(
+__kernel void reduce(__global const float* input, __global float* output, __local float* scratch)
+{
+    const uint lid = get_local_id(0);
+    scratch[lid] = input[get_global_id(0)];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1) {
+        if (lid < offset) {
+            scratch[lid] += scratch[lid + offset];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    if (lid == 0) {
+        output[get_group_id(0)] = scratch[0];
+    }
+}
+)" },
+    { "Matrix multiply", R"(
+#define TILE_SIZE 16
+__kernel void matrixMultiply(__global const float* a, __global const float* b, __global float* c, const int n)
+{
+    __local float tileA[TILE_SIZE][TILE_SIZE];
+    __local float tileB[TILE_SIZE][TILE_SIZE];
+    const int row = get_global_id(1);
+    const int col = get_global_id(0);
+    const int localRow = get_local_id(1);
+    const int localCol = get_local_id(0);
+    float sum = 0.0f;
+    for (int tile = 0; tile < n; tile += TILE_SIZE) {
+        tileA[localRow][localCol] = a[row * n + tile + localCol];
+        tileB[localRow][localCol] = b[(tile + localRow) * n + col];
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for (int k = 0; k < TILE_SIZE; k++) {
+            sum += tileA[localRow][k] * tileB[k][localCol];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    c[row * n + col] = sum;
+}
+)" },
+    { "Math built-ins", R"(
+__kernel void mathBuiltins(__global const float* input, __global float* output)
+{
+    const size_t i = get_global_id(0);
+    const float x = input[i];
+    output[i] = exp(-x * x) * sin(x) + log(1.0f + fabs(x)) / sqrt(1.0f + x * x) + pow(fabs(x), 1.5f);
+}
+)" },
+};
+
+// Hand assembled SPIR-V 1.0 module with the same vector add kernel as above, so no offline compiler is required
+// Opcodes and operand values are taken from the SPIR-V specification
+static std::vector<uint32_t> vectorAddSpirv(bool addresses64)
+{
+    enum : uint32_t {
+        idVoid = 1, idSizeType, idFloat, idSizeVector, idInputSizeVectorPtr, idGlobalFloatPtr, idFunctionType, idGlobalInvocationId,
+        idFunction, idParamA, idParamB, idParamC, idLabel, idGlobalIdVector, idGlobalId, idPtrA, idValueA, idPtrB, idValueB, idSum, idPtrC, idBound
+    };
+    // Magic number, version 1.0, generator, id bound, schema
+    std::vector<uint32_t> words = { 0x07230203, 0x00010000, 0, idBound, 0 };
+    auto op = [&words](uint32_t opcode, std::initializer_list<uint32_t> operands) {
+        words.push_back(uint32_t((operands.size() + 1) << 16) | opcode);
+        words.insert(words.end(), operands.begin(), operands.end());
+    };
+    const uint32_t alignedAccess = 0x2;
+    op(17, { 4 });                                                  // OpCapability Addresses
+    op(17, { 6 });                                                  // OpCapability Kernel
+    if (addresses64) {
+        op(17, { 11 });                                             // OpCapability Int64
+    }
+    op(14, { addresses64 ? 2u : 1u, 2 });                           // OpMemoryModel Physical64/Physical32 OpenCL
+    op(15, { 6, idFunction, 0x74636576, 0x6441726f, 0x00000064, idGlobalInvocationId }); // OpEntryPoint Kernel "vectorAdd"
+    op(71, { idGlobalInvocationId, 11, 28 });                       // OpDecorate BuiltIn GlobalInvocationId
+    op(71, { idGlobalInvocationId, 22 });                           // OpDecorate Constant
+    op(19, { idVoid });                                             // OpTypeVoid
+    op(21, { idSizeType, addresses64 ? 64u : 32u, 0 });             // OpTypeInt (size_t)
+    op(22, { idFloat, 32 });                                        // OpTypeFloat
+    op(23, { idSizeVector, idSizeType, 3 });                        // OpTypeVector
+    op(32, { idInputSizeVectorPtr, 1, idSizeVector });              // OpTypePointer Input
+    op(32, { idGlobalFloatPtr, 5, idFloat });                       // OpTypePointer CrossWorkgroup
+    op(33, { idFunctionType, idVoid, idGlobalFloatPtr, idGlobalFloatPtr, idGlobalFloatPtr }); // OpTypeFunction
+    op(59, { idInputSizeVectorPtr, idGlobalInvocationId, 1 });      // OpVariable Input
+    op(54, { idVoid, idFunction, 0, idFunctionType });              // OpFunction
+    op(55, { idGlobalFloatPtr, idParamA });                         // OpFunctionParameter
+    op(55, { idGlobalFloatPtr, idParamB });                         // OpFunctionParameter
+    op(55, { idGlobalFloatPtr, idParamC });                         // OpFunctionParameter
+    op(248, { idLabel });                                           // OpLabel
+    op(61, { idSizeVector, idGlobalIdVector, idGlobalInvocationId }); // OpLoad
+    op(81, { idSizeType, idGlobalId, idGlobalIdVector, 0 });        // OpCompositeExtract
+    op(70, { idGlobalFloatPtr, idPtrA, idParamA, idGlobalId });     // OpInBoundsPtrAccessChain
+    op(61, { idFloat, idValueA, idPtrA, alignedAccess, 4 });        // OpLoad
+    op(70, { idGlobalFloatPtr, idPtrB, idParamB, idGlobalId });     // OpInBoundsPtrAccessChain
+    op(61, { idFloat, idValueB, idPtrB, alignedAccess, 4 });        // OpLoad
+    op(129, { idFloat, idSum, idValueA, idValueB });                // OpFAdd
+    op(70, { idGlobalFloatPtr, idPtrC, idParamC, idGlobalId });     // OpInBoundsPtrAccessChain
+    op(62, { idPtrC, idSum, alignedAccess, 4 });                    // OpStore
+    op(253, {});                                                    // OpReturn
+    op(56, {});                                                     // OpFunctionEnd
+    return words;
+}
+
+// OpenCL C versions that can be passed to -cl-std (1.1 and later)
+static QStringList languageVersions(BenchmarkContext& context)
+{
+    std::vector<std::pair<int, int>> versions;
+    if (context.device.clVersionMajor >= 3) {
+        size_t valueSize = 0;
+        _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_OPENCL_C_ALL_VERSIONS, 0, nullptr, &valueSize);
+        std::vector<cl_name_version> values(valueSize / sizeof(cl_name_version));
+        if (!values.empty()) {
+            _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_OPENCL_C_ALL_VERSIONS, valueSize, values.data(), nullptr);
+        }
+        for (auto& value : values) {
+            versions.push_back({ int(CL_VERSION_MAJOR(value.version)), int(CL_VERSION_MINOR(value.version)) });
+        }
+    } else {
+        const QRegularExpressionMatch match = QRegularExpression("OpenCL C (\\d+)\\.(\\d+)").match(context.deviceString(CL_DEVICE_OPENCL_C_VERSION));
+        if (match.hasMatch()) {
+            versions.push_back({ match.captured(1).toInt(), match.captured(2).toInt() });
+        }
+    }
+    QStringList options;
+    for (auto& version : versions) {
+        const QString option = QString("-cl-std=CL%1.%2").arg(version.first).arg(version.second);
+        if (((version.first > 1) || (version.second >= 1)) && !options.contains(option)) {
+            options.append(option);
+        }
+    }
+    return options;
+}
+
+// Creates, builds and releases a program, so every call pays the full compilation cost
+static cl_int buildFromSource(BenchmarkContext& context, const QByteArray& source, const QByteArray& options)
+{
+    const char* sourcePtr = source.constData();
+    const size_t sourceLength = source.size();
+    cl_int status = CL_SUCCESS;
+    cl_program program = _clCreateProgramWithSource(context.context, 1, &sourcePtr, &sourceLength, &status);
+    if (status != CL_SUCCESS) {
+        return status;
+    }
+    status = _clBuildProgram(program, 1, &context.device.deviceId, options.constData(), nullptr, nullptr);
+    _clReleaseProgram(program);
+    return status;
+}
+
+static bool runBuilds(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    QStringList options = { "", "-cl-fast-relaxed-math" };
+    options.append(languageVersions(context));
+
+    // Drivers may cache compiled programs keyed by source and options (e.g. NVIDIA's compute cache)
+    // A unique define for every build makes sure each one actually compiles
+    int buildId = 0;
+    auto uniqueOptions = [&buildId](const QString& buildOptions) {
+        return QString("%1 -DBUILD_ID=%2").arg(buildOptions).arg(buildId++).trimmed().toUtf8();
+    };
+
+    QStringList messages;
+    std::vector<double> sourceBuildTimes;
+    for (auto& kernel : buildKernels) {
+        const QByteArray source(kernel.source);
+        double defaultBuildTime = 0.0;
+        for (auto& buildOptions : options) {
+            BenchmarkTimings timings;
+            if (!context.timeHost([&]() { return buildFromSource(context, source, uniqueOptions(buildOptions)); }, timings, error)) {
+                qWarning() << "Could not build" << kernel.name << "with options" << buildOptions << ":" << error;
+                messages.append(QString("%1 failed to build with %2").arg(kernel.name).arg(buildOptions.isEmpty() ? "default options" : buildOptions));
+                continue;
+            }
+            result.addValue(kernel.name + " source build", buildOptions.isEmpty() ? "default options" : buildOptions, timings.median() / 1e6, "ms");
+            if (buildOptions.isEmpty()) {
+                defaultBuildTime = timings.median();
+            }
+        }
+        sourceBuildTimes.push_back(defaultBuildTime);
+    }
+
+    // Reloading binaries from the on-disk cache, binaries left from a previous run are reused if the driver still accepts them
+    ProgramBinaryCache cache(context.device);
+    qInfo() << "Program binary cache:" << cache.directory();
+    int previousRunBinaries = 0;
+    for (size_t i = 0; i < std::size(buildKernels); i++) {
+        const QString source(buildKernels[i].source);
+        QByteArray binary;
+        bool cached = cache.load(source, "", binary);
+        if (cached) {
+            QString binaryError;
+            cl_program program = ProgramBinaryCache::createProgram(context.context, context.device.deviceId, binary, "", binaryError);
+            if (program) {
+                _clReleaseProgram(program);
+                previousRunBinaries++;
+            } else {
+                qWarning() << "Discarding cached binary for" << buildKernels[i].name << ":" << binaryError;
+                cache.remove(source, "");
+                cached = false;
+            }
+        }
+        if (!cached) {
+            cl_program program = context.buildProgram(source, "", error);
+            if (!program) {
+                return false;
+            }
+            QString binaryError;
+            if (!ProgramBinaryCache::getBinary(program, binary, binaryError) || !cache.store(source, "", binary, binaryError)) {
+                qWarning() << binaryError;
+                messages.append("Program binaries not available: " + binaryError);
+                break;
+            }
+        }
+        result.addValue("Binary size", buildKernels[i].name, binary.size() / 1024.0, "KiB");
+        BenchmarkTimings timings;
+        const bool reloadSuccess = context.timeHost([&]() -> cl_int {
+            QByteArray diskBinary;
+            QString binaryError;
+            if (!cache.load(source, "", diskBinary)) {
+                return CL_INVALID_BINARY;
+            }
+            cl_program program = ProgramBinaryCache::createProgram(context.context, context.device.deviceId, diskBinary, "", binaryError);
+            if (!program) {
+                return CL_INVALID_BINARY;
+            }
+            return _clReleaseProgram(program);
+        }, timings, error);
+        if (!reloadSuccess) {
+            return false;
+        }
+        result.addValue(buildKernels[i].name + " binary reload", "from disk cache", timings.median() / 1e6, "ms");
+        if ((sourceBuildTimes[i] > 0.0) && (timings.median() > 0.0)) {
+            result.addValue(buildKernels[i].name + " binary reload speedup", "relative to source build", sourceBuildTimes[i] / timings.median(), "x");
+        }
+    }
+    result.addValue("Binary cache", "binaries reused from a previous run", previousRunBinaries, "programs");
+
+    // SPIR-V ingestion is core with OpenCL 2.1 and available through cl_khr_il_program before that
+    PFN_clCreateProgramWithIL createProgramWithIL = nullptr;
+    const bool ilCore = (context.device.clVersionMajor > 2) || ((context.device.clVersionMajor == 2) && (context.device.clVersionMinor >= 1));
+    if (ilCore) {
+        createProgramWithIL = _clCreateProgramWithIL;
+    } else if (context.device.extensionSupported("cl_khr_il_program") && _clGetExtensionFunctionAddressForPlatform) {
+        createProgramWithIL = reinterpret_cast<PFN_clCreateProgramWithIL>(_clGetExtensionFunctionAddressForPlatform(context.device.platform->platformId, "clCreateProgramWithILKHR"));
+    }
+    // CL_DEVICE_IL_VERSION and CL_DEVICE_IL_VERSION_KHR share the same value
+    const bool spirvSupported = context.deviceString(CL_DEVICE_IL_VERSION).contains("SPIR-V");
+    if (createProgramWithIL && spirvSupported) {
+        const std::vector<uint32_t> spirv = vectorAddSpirv(context.deviceValue<cl_uint>(CL_DEVICE_ADDRESS_BITS) == 64);
+        BenchmarkTimings timings;
+        const bool ilSuccess = context.timeHost([&]() {
+            cl_int status = CL_SUCCESS;
+            cl_program program = createProgramWithIL(context.context, spirv.data(), spirv.size() * sizeof(uint32_t), &status);
+            if (status != CL_SUCCESS) {
+                return status;
+            }
+            status = _clBuildProgram(program, 1, &context.device.deviceId, uniqueOptions("").constData(), nullptr, nullptr);
+            _clReleaseProgram(program);
+            return status;
+        }, timings, error);
+        if (ilSuccess) {
+            result.addValue("Vector add SPIR-V build", "clCreateProgramWithIL", timings.median() / 1e6, "ms");
+            if ((sourceBuildTimes[0] > 0.0) && (timings.median() > 0.0)) {
+                result.addValue("Vector add SPIR-V build speedup", "relative to source build", sourceBuildTimes[0] / timings.median(), "x");
+            }
+        } else {
+            qWarning() << "Could not build SPIR-V module:" << error;
+            messages.append("SPIR-V module could not be built: " + error);
+        }
+    }
+
+    result.message = messages.join("\n");
+    return true;
+}
+
+bool BuildBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // Builds take far longer than the operations timed by other benchmarks, so fewer runs are used
+    const BenchmarkSettings settings = context.settings;
+    context.settings.warmupIterations = 1;
+    context.settings.iterations = std::min(settings.iterations, 5u);
+    const bool success = runBuilds(context, result, error);
+    context.settings = settings;
+    return success;
+}
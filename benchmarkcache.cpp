@@ -0,0 +1,213 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// Single work item pointer chase, the position is kept in the state buffer so consecutive runs continue where the last one stopped
+static const char* cacheSource = R"(
+__kernel void chase(__global const uint* chain, __global uint* state, const int warmupSteps, const int steps)
+{
+    if (get_global_id(0) == 0) {
+        uint index = state[0];
+        for (int i = 0; i < warmupSteps; i++) {
+            index = chain[index];
+        }
+        for (int i = 0; i < steps; i++) {
+            index = chain[index];
+        }
+        state[0] = index;
+    }
+}
+)";
+
+struct CacheLevel
+{
+    size_t size;
+    double latency;
+};
+
+// Uploads the first elements of the chain and resets the chase to start at the first element
+static bool uploadChain(BenchmarkContext& context, cl_mem chainBuffer, cl_mem stateBuffer, const std::vector<cl_uint>& chain, size_t elements, QString& error)
+{
+    const cl_uint start = 0;
+    cl_int status = _clEnqueueWriteBuffer(context.queue, chainBuffer, CL_TRUE, 0, elements * sizeof(cl_uint), chain.data(), 0, nullptr, nullptr);
+    if (status == CL_SUCCESS) {
+        status = _clEnqueueWriteBuffer(context.queue, stateBuffer, CL_TRUE, 0, sizeof(cl_uint), &start, 0, nullptr, nullptr);
+    }
+    if (status != CL_SUCCESS) {
+        error = "Could not upload pointer chain: " + utils::errorString(status);
+        return false;
+    }
+    return true;
+}
+
+// Returns the average time per step, with the launch overhead and the in-kernel warmup removed
+static bool stepLatency(BenchmarkContext& context, cl_kernel kernel, cl_int warmupSteps, double& latency, QString& error)
+{
+    const cl_int steps = 32768;
+    const cl_int noSteps = 0;
+    const size_t globalSize = 1;
+    BenchmarkTimings baseTimings;
+    BenchmarkTimings chaseTimings;
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &warmupSteps);
+    _clSetKernelArg(kernel, 3, sizeof(cl_int), &noSteps);
+    if (!context.timeKernel(kernel, 1, &globalSize, &globalSize, baseTimings, error)) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 3, sizeof(cl_int), &steps);
+    if (!context.timeKernel(kernel, 1, &globalSize, &globalSize, chaseTimings, error)) {
+        return false;
+    }
+    latency = std::max(chaseTimings.median() - baseTimings.median(), 0.0) / steps;
+    return true;
+}
+
+bool CacheBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const cl_device_mem_cache_type cacheType = context.deviceValue<cl_device_mem_cache_type>(CL_DEVICE_GLOBAL_MEM_CACHE_TYPE);
+    const cl_ulong reportedCacheSize = context.deviceValue<cl_ulong>(CL_DEVICE_GLOBAL_MEM_CACHE_SIZE);
+    const cl_uint reportedLineSize = context.deviceValue<cl_uint>(CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE);
+
+    // The largest working set needs to exceed all caches, including the one reported by the device
+    size_t maxSize = size_t(64) * 1024 * 1024;
+    while ((maxSize < reportedCacheSize * 4) && (maxSize < size_t(1024) * 1024 * 1024)) {
+        maxSize *= 2;
+    }
+    while ((maxSize > context.maxBufferSize()) && (maxSize > 1024 * 1024)) {
+        maxSize /= 2;
+    }
+
+    cl_program program = context.buildProgram(cacheSource, "", error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel kernel = context.createKernel(program, "chase", error);
+    if (!kernel) {
+        return false;
+    }
+    cl_mem chainBuffer = context.createBuffer(CL_MEM_READ_ONLY, maxSize, nullptr, error);
+    cl_mem stateBuffer = context.createBuffer(CL_MEM_READ_WRITE, sizeof(cl_uint), nullptr, error);
+    if (!chainBuffer || !stateBuffer) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 0, sizeof(cl_mem), &chainBuffer);
+    _clSetKernelArg(kernel, 1, sizeof(cl_mem), &stateBuffer);
+
+    const cl_uint elementCount = cl_uint(maxSize / sizeof(cl_uint));
+    std::vector<cl_uint> chain(elementCount);
+    QStringList discrepancies;
+
+    // Line size: sequential chases through the whole buffer, where every access to a new line misses
+    // The time per access grows with the stride until the stride reaches the line size
+    std::vector<std::pair<cl_uint, double>> strideLatencies;
+    for (cl_uint stride = sizeof(cl_uint); stride <= 1024; stride *= 2) {
+        const cl_uint step = stride / sizeof(cl_uint);
+        for (cl_uint i = 0; i < elementCount; i++) {
+            chain[i] = (i + step) % elementCount;
+        }
+        double latency = 0.0;
+        if (!uploadChain(context, chainBuffer, stateBuffer, chain, elementCount, error) || !stepLatency(context, kernel, 0, latency, error)) {
+            return false;
+        }
+        strideLatencies.push_back({ stride, latency });
+        result.addValue("Sequential latency", QString("%1 byte stride").arg(stride), latency, "ns");
+    }
+    cl_uint inferredLineSize = 0;
+    for (size_t i = 0; i + 1 < strideLatencies.size(); i++) {
+        if (strideLatencies[i + 1].second < strideLatencies[i].second * 1.25) {
+            inferredLineSize = strideLatencies[i].first;
+            break;
+        }
+    }
+    // Hardware prefetchers can hide the misses of sequential accesses, which results in a flat curve without a usable plateau
+    if (strideLatencies.back().second < strideLatencies.front().second * 1.5) {
+        inferredLineSize = 0;
+    }
+    if (inferredLineSize > 0) {
+        result.addValue("Cache line size", "inferred", inferredLineSize, "bytes");
+        const bool lineSizeMatches = (reportedLineSize == inferredLineSize);
+        result.addValue("Cache line size", lineSizeMatches ? "reported" : "reported, differs from inferred", reportedLineSize, "bytes");
+        if (!lineSizeMatches) {
+            discrepancies.append("cache line size");
+        }
+    } else {
+        result.addValue("Cache line size", "reported, could not be inferred", reportedLineSize, "bytes");
+    }
+
+    // Cache sizes: random chases over one element per line for growing working sets, the latency jumps once a working set exceeds a cache level
+    const cl_uint lineSize = (inferredLineSize > 0) ? inferredLineSize : ((reportedLineSize > 0) ? reportedLineSize : 64);
+    const cl_uint lineStep = std::max(lineSize / cl_uint(sizeof(cl_uint)), 1u);
+    std::vector<std::pair<size_t, double>> sizeLatencies;
+    for (size_t size = 1024; size <= maxSize; size *= 2) {
+        const cl_uint lines = std::max(cl_uint(size / (lineStep * sizeof(cl_uint))), 1u);
+        const std::vector<cl_uint> cycle = randomCycle(lines);
+        for (cl_uint i = 0; i < lines; i++) {
+            chain[i * lineStep] = cycle[i] * lineStep;
+        }
+        // Walking the working set once per run refills caches that don't persist between kernel launches (e.g. GPU L1)
+        const cl_int warmupSteps = cl_int(std::min(lines, 65536u));
+        double latency = 0.0;
+        if (!uploadChain(context, chainBuffer, stateBuffer, chain, size / sizeof(cl_uint), error) || !stepLatency(context, kernel, warmupSteps, latency, error)) {
+            return false;
+        }
+        sizeLatencies.push_back({ size, latency });
+        result.addValue("Random latency", sizeString(size), latency, "ns");
+    }
+
+    // A level ends at the last working set before a latency jump, consecutive jumps belong to the same transition
+    std::vector<CacheLevel> levels;
+    bool transition = false;
+    for (size_t i = 1; i < sizeLatencies.size(); i++) {
+        const bool jump = (sizeLatencies[i].second > sizeLatencies[i - 1].second * 1.3);
+        if (jump && !transition) {
+            levels.push_back({ sizeLatencies[i - 1].first, sizeLatencies[i - 1].second });
+        }
+        transition = jump;
+    }
+    for (size_t i = 0; i < levels.size(); i++) {
+        const QString levelName = QString("Level %1 cache").arg(i + 1);
+        result.addValue(levelName, "inferred size", levels[i].size / 1024.0, "KiB");
+        result.addValue(levelName, "latency", levels[i].latency, "ns");
+    }
+    result.addValue("Memory latency", transition ? sizeString(maxSize) + ", still rising" : sizeString(maxSize), sizeLatencies.back().second, "ns");
+
+    // Working sets are powers of two, so a reported size within a factor of two of an inferred level is considered a match
+    if (cacheType == CL_NONE) {
+        result.addValue("Global memory cache size", "reported, no cache type reported", reportedCacheSize / 1024.0, "KiB");
+    } else {
+        bool cacheSizeMatches = false;
+        for (auto& level : levels) {
+            if ((reportedCacheSize >= level.size / 2) && (reportedCacheSize <= level.size * 2)) {
+                cacheSizeMatches = true;
+            }
+        }
+        result.addValue("Global memory cache size", cacheSizeMatches ? "reported" : "reported, no inferred level within a factor of two", reportedCacheSize / 1024.0, "KiB");
+        if (!cacheSizeMatches) {
+            discrepancies.append("global memory cache size");
+        }
+    }
+
+    if (levels.empty()) {
+        result.message = "No cache levels could be inferred";
+    } else if (!discrepancies.isEmpty()) {
+        result.message = "Inferred values differ from the reported " + discrepancies.join(" and ");
+    }
+    return true;
+}
@@ -0,0 +1,208 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// Each kernel increments all elements, so the final values tell how many kernels of a sequence actually ran
+static const char* commandBufferSource = R"(
+__kernel void increment(__global uint* data)
+{
+    data[get_global_id(0)] += 1;
+}
+)";
+
+static const cl_uint sequenceLengths[] = { 1, 4, 16, 64, 256 };
+
+// cl_khr_command_buffer entry points, these are only available through the extension function address
+struct CommandBufferFunctions
+{
+    clCreateCommandBufferKHR_fn create = nullptr;
+    clFinalizeCommandBufferKHR_fn finalize = nullptr;
+    clReleaseCommandBufferKHR_fn release = nullptr;
+    clCommandNDRangeKernelKHR_fn commandNDRangeKernel = nullptr;
+    clEnqueueCommandBufferKHR_fn enqueue = nullptr;
+};
+
+static CommandBufferFunctions commandBufferFunctions(BenchmarkContext& context)
+{
+    CommandBufferFunctions functions;
+    if (_clGetExtensionFunctionAddressForPlatform) {
+        cl_platform_id platform = context.device.platform->platformId;
+        functions.create = reinterpret_cast<clCreateCommandBufferKHR_fn>(_clGetExtensionFunctionAddressForPlatform(platform, "clCreateCommandBufferKHR"));
+        functions.finalize = reinterpret_cast<clFinalizeCommandBufferKHR_fn>(_clGetExtensionFunctionAddressForPlatform(platform, "clFinalizeCommandBufferKHR"));
+        functions.release = reinterpret_cast<clReleaseCommandBufferKHR_fn>(_clGetExtensionFunctionAddressForPlatform(platform, "clReleaseCommandBufferKHR"));
+        functions.commandNDRangeKernel = reinterpret_cast<clCommandNDRangeKernelKHR_fn>(_clGetExtensionFunctionAddressForPlatform(platform, "clCommandNDRangeKernelKHR"));
+        functions.enqueue = reinterpret_cast<clEnqueueCommandBufferKHR_fn>(_clGetExtensionFunctionAddressForPlatform(platform, "clEnqueueCommandBufferKHR"));
+    }
+    return functions;
+}
+
+// Releases the command buffer when going out of scope, so early returns don't leak it
+struct CommandBuffer
+{
+    const CommandBufferFunctions& functions;
+    cl_command_buffer_khr handle = nullptr;
+    CommandBuffer(const CommandBufferFunctions& functions) : functions(functions) {}
+    ~CommandBuffer()
+    {
+        if (handle) {
+            functions.release(handle);
+        }
+    }
+};
+
+bool CommandBufferBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (!context.device.extensionSupported("cl_khr_command_buffer")) {
+        reason = "Device does not support cl_khr_command_buffer";
+        return false;
+    }
+    const CommandBufferFunctions functions = commandBufferFunctions(context);
+    if (!functions.create || !functions.finalize || !functions.release || !functions.commandNDRangeKernel || !functions.enqueue) {
+        reason = "Command buffer entry points not available";
+        return false;
+    }
+    return true;
+}
+
+bool CommandBufferBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const CommandBufferFunctions functions = commandBufferFunctions(context);
+    // Command buffers can only be created for queues with the properties required by the device, direct enqueues use the same queue
+    const cl_command_queue_properties requiredProperties = context.deviceValue<cl_command_queue_properties>(CL_DEVICE_COMMAND_BUFFER_REQUIRED_QUEUE_PROPERTIES_KHR);
+    cl_command_queue queue = context.queue;
+    if (requiredProperties & ~cl_command_queue_properties(CL_QUEUE_PROFILING_ENABLE)) {
+        queue = context.createQueue(requiredProperties | CL_QUEUE_PROFILING_ENABLE, error);
+        if (!queue) {
+            return false;
+        }
+    }
+    const bool outOfOrder = (requiredProperties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+
+    cl_program program = context.buildProgram(commandBufferSource, "", error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel kernel = context.createKernel(program, "increment", error);
+    if (!kernel) {
+        return false;
+    }
+    // Small dispatches, so the measured times are dominated by submission and scheduling
+    const size_t globalSize = 64;
+    std::vector<cl_uint> zeros(globalSize, 0);
+    cl_mem dataBuffer = context.createBuffer(CL_MEM_READ_WRITE, globalSize * sizeof(cl_uint), nullptr, error);
+    if (!dataBuffer) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 0, sizeof(cl_mem), &dataBuffer);
+
+    QStringList failedValidations;
+    for (cl_uint length : sequenceLengths) {
+        const QString detail = QString("%1 %2").arg(length).arg((length == 1) ? "kernel" : "kernels");
+
+        // Direct enqueue of the sequence, on an out-of-order queue barriers keep the kernels in order like the sync points of the command buffer
+        BenchmarkTimings directSubmitTimings;
+        BenchmarkTimings directTimings;
+        const bool directSuccess = context.timeHost([&]() {
+            const auto start = std::chrono::steady_clock::now();
+            for (cl_uint i = 0; i < length; i++) {
+                cl_int status = _clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr);
+                if ((status == CL_SUCCESS) && outOfOrder && (i + 1 < length)) {
+                    status = _clEnqueueBarrierWithWaitList(queue, 0, nullptr, nullptr);
+                }
+                if (status != CL_SUCCESS) {
+                    return status;
+                }
+            }
+            directSubmitTimings.samples.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            return _clFinish(queue);
+        }, directTimings, error);
+        if (!directSuccess) {
+            return false;
+        }
+
+        // Recording the same sequence as a chain of sync points
+        CommandBuffer commandBuffer(functions);
+        const auto recordStart = std::chrono::steady_clock::now();
+        cl_int status = CL_SUCCESS;
+        commandBuffer.handle = functions.create(1, &queue, nullptr, &status);
+        cl_sync_point_khr syncPoint = 0;
+        for (cl_uint i = 0; (i < length) && (status == CL_SUCCESS); i++) {
+            const cl_sync_point_khr previousSyncPoint = syncPoint;
+            status = functions.commandNDRangeKernel(commandBuffer.handle, nullptr, nullptr, kernel, 1, nullptr, &globalSize, nullptr, (i > 0) ? 1 : 0, (i > 0) ? &previousSyncPoint : nullptr, &syncPoint, nullptr);
+        }
+        if (status == CL_SUCCESS) {
+            status = functions.finalize(commandBuffer.handle);
+        }
+        const auto recordEnd = std::chrono::steady_clock::now();
+        if (status != CL_SUCCESS) {
+            error = "Could not record command buffer: " + utils::errorString(status);
+            return false;
+        }
+
+        // Replays, the data buffer is reset first so the final values can be validated
+        status = _clEnqueueWriteBuffer(queue, dataBuffer, CL_TRUE, 0, globalSize * sizeof(cl_uint), zeros.data(), 0, nullptr, nullptr);
+        if (status != CL_SUCCESS) {
+            error = "Could not reset data buffer: " + utils::errorString(status);
+            return false;
+        }
+        BenchmarkTimings replaySubmitTimings;
+        BenchmarkTimings replayTimings;
+        const bool replaySuccess = context.timeHost([&]() {
+            const auto start = std::chrono::steady_clock::now();
+            const cl_int replayStatus = functions.enqueue(0, nullptr, commandBuffer.handle, 0, nullptr, nullptr);
+            if (replayStatus != CL_SUCCESS) {
+                return replayStatus;
+            }
+            replaySubmitTimings.samples.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            return _clFinish(queue);
+        }, replayTimings, error);
+        if (!replaySuccess) {
+            return false;
+        }
+        std::vector<cl_uint> data(globalSize, 0);
+        status = _clEnqueueReadBuffer(queue, dataBuffer, CL_TRUE, 0, globalSize * sizeof(cl_uint), data.data(), 0, nullptr, nullptr);
+        if (status != CL_SUCCESS) {
+            error = "Could not read data buffer: " + utils::errorString(status);
+            return false;
+        }
+        const cl_uint expected = (context.settings.warmupIterations + context.settings.iterations) * length;
+        if (std::count(data.begin(), data.end(), expected) != int(globalSize)) {
+            failedValidations.append(detail);
+        }
+
+        const double directLatency = directTimings.median();
+        const double replayLatency = replayTimings.median();
+        result.addValue("Command buffer recording", detail, std::chrono::duration_cast<std::chrono::nanoseconds>(recordEnd - recordStart).count() / 1000.0, "us");
+        result.addValue("Direct enqueue submission", detail, directSubmitTimings.median() / 1000.0, "us");
+        result.addValue("Command buffer replay submission", detail, replaySubmitTimings.median() / 1000.0, "us");
+        result.addValue("Direct enqueue latency", detail, directLatency / 1000.0, "us");
+        result.addValue("Command buffer replay latency", detail, replayLatency / 1000.0, "us");
+        if ((directLatency > 0.0) && (replayLatency > 0.0)) {
+            result.addValue("Direct enqueue throughput", detail, length / (directLatency / 1e9), "dispatches/s");
+            result.addValue("Command buffer replay throughput", detail, length / (replayLatency / 1e9), "dispatches/s");
+            result.addValue("Command buffer replay speedup", detail, directLatency / replayLatency, "x");
+        }
+    }
+    if (!failedValidations.isEmpty()) {
+        result.message = "Replayed command buffers did not run all kernels: " + failedValidations.join(", ");
+    }
+    return true;
+}
@@ -0,0 +1,185 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+struct ComputeType
+{
+    QString name;
+    // OpenCL C scalar type
+    QString scalarType;
+    size_t scalarSize;
+    bool floatingPoint;
+    // Extension that needs to be supported (and enabled in the kernel source), empty for core types
+    QString extension;
+    // Floating point capabilities reported by the device, zero for integer types
+    cl_device_info fpConfig;
+};
+
+static const cl_uint vectorWidths[] = { 1, 2, 4, 8, 16 };
+
+// Independent accumulators per work item, so the compiler can interleave the dependent mad chains
+static const int madChains = 8;
+static const int madUnroll = 16;
+
+// Generates one kernel per vector width, each work item runs iterations * madChains * madUnroll mads
+static QString generateMadSource(const ComputeType& computeType)
+{
+    QString source;
+    if (!computeType.extension.isEmpty()) {
+        source += "#pragma OPENCL EXTENSION " + computeType.extension + " : enable\n";
+    }
+    for (cl_uint width : vectorWidths) {
+        const QString type = (width == 1) ? computeType.scalarType : computeType.scalarType + QString::number(width);
+        source += QString("__kernel void mad_%1(__global %2* output, const float seed, const uint multiplier, const int iterations)\n{\n").arg(width).arg(type);
+        // Values depend on kernel arguments and ids, so nothing can be folded at compile time
+        if (computeType.floatingPoint) {
+            // With m < 1 and a non-zero addend the chains settle near c / (1 - m) (500 or 1500 for seed 0.999, lower at half precision) instead of decaying into denormals
+            source += QString("    const %1 m = (%1)(seed);\n").arg(type);
+            source += QString("    const %1 c = (%1)(0.5f + (float)(get_local_id(0) & 1));\n").arg(type);
+            for (int chain = 0; chain < madChains; chain++) {
+                source += QString("    %1 a%2 = (%1)(seed + %2.0f);\n").arg(type).arg(chain);
+            }
+        } else {
+            // Integer chains wrap around, an odd multiplier keeps them from collapsing to a constant
+            source += QString("    const %1 m = (%1)(multiplier);\n").arg(type);
+            source += QString("    const %1 c = (%1)(1 + (get_local_id(0) & 1));\n").arg(type);
+            for (int chain = 0; chain < madChains; chain++) {
+                source += QString("    %1 a%2 = (%1)(multiplier + %2);\n").arg(type).arg(chain);
+            }
+        }
+        source += "    for (int i = 0; i < iterations; i++) {\n";
+        for (int unroll = 0; unroll < madUnroll; unroll++) {
+            for (int chain = 0; chain < madChains; chain++) {
+                if (computeType.floatingPoint) {
+                    source += QString("        a%1 = mad(a%1, m, c);\n").arg(chain);
+                } else {
+                    source += QString("        a%1 = a%1 * m + c;\n").arg(chain);
+                }
+            }
+        }
+        source += "    }\n";
+        source += "    output[get_global_id(0)] = a0";
+        for (int chain = 1; chain < madChains; chain++) {
+            source += QString(" + a%1").arg(chain);
+        }
+        source += ";\n}\n\n";
+    }
+    return source;
+}
+
+bool ComputeBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const std::vector<ComputeType> computeTypes = {
+        { "float", "float", sizeof(cl_float), true, "", CL_DEVICE_SINGLE_FP_CONFIG },
+        { "half", "half", sizeof(cl_half), true, "cl_khr_fp16", CL_DEVICE_HALF_FP_CONFIG },
+        { "double", "double", sizeof(cl_double), true, "cl_khr_fp64", CL_DEVICE_DOUBLE_FP_CONFIG },
+        { "int32", "uint", sizeof(cl_uint), false, "", 0 },
+        { "int16", "ushort", sizeof(cl_ushort), false, "", 0 },
+        { "int8", "uchar", sizeof(cl_uchar), false, "", 0 },
+    };
+
+    const cl_uint computeUnits = context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS);
+    const cl_uint clockFrequency = context.deviceValue<cl_uint>(CL_DEVICE_MAX_CLOCK_FREQUENCY);
+    result.addValue("Compute units", double(computeUnits), "");
+    result.addValue("Clock frequency", double(clockFrequency), "MHz");
+
+    double floatPeak = 0.0;
+    for (auto& computeType : computeTypes) {
+        if (!computeType.extension.isEmpty() && !context.device.extensionSupported(computeType.extension.toLatin1().constData())) {
+            continue;
+        }
+        cl_program program = context.buildProgram(generateMadSource(computeType), "", error);
+        if (!program) {
+            return false;
+        }
+        const QString unit = computeType.floatingPoint ? "GFLOPS" : "GIOPS";
+        double peak = 0.0;
+        cl_uint peakWidth = 1;
+        for (cl_uint width : vectorWidths) {
+            cl_kernel kernel = context.createKernel(program, QString("mad_%1").arg(width).toLatin1().constData(), error);
+            if (!kernel) {
+                return false;
+            }
+            // Work group size is a multiple of the preferred multiple, with enough groups to fill all compute units several times
+            // The device level preferred multiple was added with OpenCL 3.0, older devices only report it per kernel
+            size_t preferredMultiple = 0;
+            size_t maxWorkGroupSize = 1;
+            if (context.device.clVersionMajor >= 3) {
+                preferredMultiple = context.deviceValue<size_t>(CL_DEVICE_PREFERRED_WORK_GROUP_SIZE_MULTIPLE);
+            }
+            if (preferredMultiple == 0) {
+                _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, sizeof(size_t), &preferredMultiple, nullptr);
+            }
+            _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxWorkGroupSize, nullptr);
+            preferredMultiple = std::max(preferredMultiple, size_t(1));
+            size_t localSize = std::min(maxWorkGroupSize, size_t(256));
+            localSize = std::max(localSize - (localSize % preferredMultiple), std::min(preferredMultiple, maxWorkGroupSize));
+            const size_t globalSize = localSize * std::max(computeUnits, 1u) * 8;
+
+            cl_mem outputBuffer = context.createBuffer(CL_MEM_WRITE_ONLY, globalSize * width * computeType.scalarSize, nullptr, error);
+            if (!outputBuffer) {
+                return false;
+            }
+            const cl_float seed = 0.999f;
+            const cl_uint multiplier = 3;
+            _clSetKernelArg(kernel, 0, sizeof(cl_mem), &outputBuffer);
+            _clSetKernelArg(kernel, 1, sizeof(cl_float), &seed);
+            _clSetKernelArg(kernel, 2, sizeof(cl_uint), &multiplier);
+            cl_int iterations = 0;
+            if (!calibrateIterations(context, kernel, 3, globalSize, localSize, iterations, error)) {
+                return false;
+            }
+            BenchmarkTimings timings;
+            if (!context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error)) {
+                return false;
+            }
+            context.releaseBuffer(outputBuffer);
+            // Each mad counts as two operations
+            const double operations = 2.0 * globalSize * double(iterations) * madChains * madUnroll * width;
+            const double throughput = (timings.median() > 0.0) ? operations / timings.median() : 0.0;
+            const QString typeName = (width == 1) ? computeType.scalarType : computeType.scalarType + QString::number(width);
+            result.addValue(computeType.name, typeName, throughput, unit);
+            if (throughput > peak) {
+                peak = throughput;
+                peakWidth = width;
+            }
+        }
+
+        // Absolute theoretical peaks would require the number of lanes per compute unit which OpenCL doesn't report,
+        // so the measured peak is normalized to operations per clock and compute unit instead
+        QString detail = QString("width %1").arg(peakWidth);
+        if (computeType.fpConfig != 0) {
+            const cl_device_fp_config fpConfig = context.deviceValue<cl_device_fp_config>(computeType.fpConfig);
+            detail += (fpConfig & CL_FP_FMA) ? ", CL_FP_FMA reported" : ", no CL_FP_FMA reported";
+        }
+        result.addValue(computeType.name + " peak", detail, peak, unit);
+        if ((computeUnits > 0) && (clockFrequency > 0)) {
+            result.addValue(computeType.name + " peak per clock", "per compute unit", (peak * 1e9) / (double(computeUnits) * clockFrequency * 1e6), "ops/clk");
+        }
+        if (computeType.name == "float") {
+            floatPeak = peak;
+        } else if (computeType.floatingPoint && (floatPeak > 0.0)) {
+            // Emulated or throttled paths show up as a rate far below the one expected for the type (e.g. 1/2 for double, 2 for half)
+            result.addValue(computeType.name + " rate", "relative to float", peak / floatPeak, "x");
+        }
+    }
+    return true;
+}
@@ -0,0 +1,340 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// counters[0] counts executed children, counters[1] enqueues rejected by the device (e.g. because the queue is full)
+// The reduction reads factor elements per work-item and pass, the recursive variant launches the next pass from the device
+static const char* deviceEnqueueSource = R"(
+__kernel void increment(__global uint* counters)
+{
+    atomic_inc(&counters[0]);
+}
+
+__kernel void launchChildren(__global uint* counters, uint children, queue_t queue)
+{
+    for (uint i = 0; i < children; i++) {
+        if (enqueue_kernel(queue, CLK_ENQUEUE_FLAGS_NO_WAIT, ndrange_1D(1), ^{ atomic_inc(&counters[0]); }) != CLK_SUCCESS) {
+            atomic_inc(&counters[1]);
+        }
+    }
+}
+
+uint reduceSlice(__global const uint* input, uint count, uint factor)
+{
+    const uint first = get_global_id(0) * factor;
+    const uint last = min(first + factor, count);
+    uint sum = 0;
+    for (uint i = first; i < last; i++) {
+        sum += input[i];
+    }
+    return sum;
+}
+
+__kernel void reducePass(__global const uint* input, __global uint* output, uint count, uint factor)
+{
+    output[get_global_id(0)] = reduceSlice(input, count, factor);
+}
+
+__kernel void reduceRecursive(__global const uint* input, __global uint* output, __global uint* scratch, uint count, uint factor, queue_t queue)
+{
+    output[get_global_id(0)] = reduceSlice(input, count, factor);
+    const uint remaining = (count + factor - 1) / factor;
+    if ((get_global_id(0) == 0) && (remaining > 1)) {
+        enqueue_kernel(queue, CLK_ENQUEUE_FLAGS_WAIT_KERNEL, ndrange_1D((remaining + factor - 1) / factor), ^{ reduceRecursive(output, scratch, output, remaining, factor, queue); });
+    }
+}
+)";
+
+static const cl_uint childCounts[] = { 1, 16, 256, 1024 };
+static const cl_uint reductionFactors[] = { 4, 16 };
+// Children launched per run of the queue size sweep, spread over several parent work-items so the queue actually fills up
+static const cl_uint sweepParents = 64;
+static const cl_uint sweepChildren = 64;
+
+bool DeviceEnqueueBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (context.device.clVersionMajor < 2) {
+        reason = "Device-side enqueue requires OpenCL 2.0";
+        return false;
+    }
+    // Optional since OpenCL 3.0
+    if ((context.device.clVersionMajor >= 3) && !(context.deviceValue<cl_device_device_enqueue_capabilities>(CL_DEVICE_DEVICE_ENQUEUE_CAPABILITIES) & CL_DEVICE_QUEUE_SUPPORTED)) {
+        reason = "Device does not support device-side enqueue";
+        return false;
+    }
+    if (!_clCreateCommandQueueWithProperties) {
+        reason = "clCreateCommandQueueWithProperties is not available";
+        return false;
+    }
+    return true;
+}
+
+bool DeviceEnqueueBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const QString languageVersion = (context.device.clVersionMajor >= 3) ? "-cl-std=CL3.0" : "-cl-std=CL2.0";
+    cl_program program = context.buildProgram(deviceEnqueueSource, languageVersion, error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel incrementKernel = context.createKernel(program, "increment", error);
+    cl_kernel launchKernel = incrementKernel ? context.createKernel(program, "launchChildren", error) : nullptr;
+    cl_kernel reducePassKernel = launchKernel ? context.createKernel(program, "reducePass", error) : nullptr;
+    cl_kernel reduceRecursiveKernel = reducePassKernel ? context.createKernel(program, "reduceRecursive", error) : nullptr;
+    if (!reduceRecursiveKernel) {
+        return false;
+    }
+
+    const cl_uint preferredQueueSize = context.deviceValue<cl_uint>(CL_DEVICE_QUEUE_ON_DEVICE_PREFERRED_SIZE);
+    const cl_uint maxQueueSize = context.deviceValue<cl_uint>(CL_DEVICE_QUEUE_ON_DEVICE_MAX_SIZE);
+    const cl_uint runs = context.settings.warmupIterations + context.settings.iterations;
+    const cl_uint zeroCounters[2] = { 0, 0 };
+    cl_mem counterBuffer = context.createBuffer(CL_MEM_READ_WRITE, sizeof(zeroCounters), nullptr, error);
+    if (!counterBuffer) {
+        return false;
+    }
+    auto resetCounters = [&]() {
+        return _clEnqueueWriteBuffer(context.queue, counterBuffer, CL_TRUE, 0, sizeof(zeroCounters), zeroCounters, 0, nullptr, nullptr);
+    };
+    auto readCounters = [&](cl_uint* counters) {
+        return _clEnqueueReadBuffer(context.queue, counterBuffer, CL_TRUE, 0, sizeof(zeroCounters), counters, 0, nullptr, nullptr);
+    };
+    QStringList rejectedEnqueues;
+
+    cl_command_queue deviceQueue = context.createDeviceQueue(preferredQueueSize, error);
+    if (!deviceQueue) {
+        return false;
+    }
+
+    // Child launch latency and overhead, compared against the same number of single work-item kernels enqueued from the host
+    const size_t one = 1;
+    _clSetKernelArg(launchKernel, 0, sizeof(cl_mem), &counterBuffer);
+    _clSetKernelArg(launchKernel, 2, sizeof(cl_command_queue), &deviceQueue);
+    _clSetKernelArg(incrementKernel, 0, sizeof(cl_mem), &counterBuffer);
+    double deviceLatencyFirst = 0.0;
+    double deviceLatencyLast = 0.0;
+    double hostLatencyFirst = 0.0;
+    double hostLatencyLast = 0.0;
+    for (cl_uint children : childCounts) {
+        const QString detail = QString("%1 %2").arg(children).arg((children == 1) ? "child" : "children");
+        cl_int status = resetCounters();
+        if (status != CL_SUCCESS) {
+            error = "Could not reset counters: " + utils::errorString(status);
+            return false;
+        }
+        _clSetKernelArg(launchKernel, 1, sizeof(cl_uint), &children);
+        BenchmarkTimings deviceTimings;
+        // The parent kernel only completes once all of its children have completed
+        const bool deviceSuccess = context.timeHost([&]() {
+            const cl_int enqueueStatus = _clEnqueueNDRangeKernel(context.queue, launchKernel, 1, nullptr, &one, &one, 0, nullptr, nullptr);
+            return (enqueueStatus == CL_SUCCESS) ? _clFinish(context.queue) : enqueueStatus;
+        }, deviceTimings, error);
+        if (!deviceSuccess) {
+            return false;
+        }
+        cl_uint counters[2] = {};
+        status = readCounters(counters);
+        if (status != CL_SUCCESS) {
+            error = "Could not read counters: " + utils::errorString(status);
+            return false;
+        }
+        if (counters[1] > 0) {
+            rejectedEnqueues.append(QString("%1 of %2 children at %3").arg(counters[1]).arg(runs * children).arg(sizeString(preferredQueueSize)));
+        }
+
+        BenchmarkTimings hostTimings;
+        const bool hostSuccess = context.timeHost([&]() {
+            for (cl_uint i = 0; i < children; i++) {
+                const cl_int enqueueStatus = _clEnqueueNDRangeKernel(context.queue, incrementKernel, 1, nullptr, &one, &one, 0, nullptr, nullptr);
+                if (enqueueStatus != CL_SUCCESS) {
+                    return enqueueStatus;
+                }
+            }
+            return _clFinish(context.queue);
+        }, hostTimings, error);
+        if (!hostSuccess) {
+            return false;
+        }
+
+        const double deviceLatency = deviceTimings.median();
+        const double hostLatency = hostTimings.median();
+        result.addValue("Device-side enqueue latency", detail, deviceLatency / 1000.0, "us");
+        result.addValue("Host enqueue latency", detail, hostLatency / 1000.0, "us");
+        if (children == childCounts[0]) {
+            deviceLatencyFirst = deviceLatency;
+            hostLatencyFirst = hostLatency;
+        }
+        deviceLatencyLast = deviceLatency;
+        hostLatencyLast = hostLatency;
+    }
+    // Cost of each additional launch, without the fixed cost of getting the first kernel onto the device
+    const cl_uint childSpan = childCounts[std::size(childCounts) - 1] - childCounts[0];
+    result.addValue("Device-side enqueue overhead", "per child launch", std::max(deviceLatencyLast - deviceLatencyFirst, 0.0) / childSpan / 1000.0, "us");
+    result.addValue("Host enqueue overhead", "per kernel launch", std::max(hostLatencyLast - hostLatencyFirst, 0.0) / childSpan / 1000.0, "us");
+
+    // Recursive tree reduction launching each pass from the device, compared against the host enqueueing each pass
+    size_t elementCount = size_t(4) * 1024 * 1024;
+    while ((elementCount * sizeof(cl_uint) > context.maxBufferSize()) && (elementCount > 1024)) {
+        elementCount /= 2;
+    }
+    std::vector<cl_uint> hostData(elementCount);
+    cl_uint expectedSum = 0;
+    for (size_t i = 0; i < elementCount; i++) {
+        hostData[i] = cl_uint(i & 0xff);
+        expectedSum += hostData[i];
+    }
+    cl_mem sourceBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, elementCount * sizeof(cl_uint), hostData.data(), error);
+    if (!sourceBuffer) {
+        return false;
+    }
+    // Passes alternate between the two scratch buffers, the source is never written
+    cl_mem passBuffers[2] = {};
+    for (auto& buffer : passBuffers) {
+        buffer = context.createBuffer(CL_MEM_READ_WRITE, (elementCount / reductionFactors[0] + 1) * sizeof(cl_uint), nullptr, error);
+        if (!buffer) {
+            return false;
+        }
+    }
+    QStringList failedValidations;
+    for (cl_uint factor : reductionFactors) {
+        std::vector<cl_uint> passCounts;
+        for (cl_uint count = cl_uint(elementCount); count > 1; count = (count + factor - 1) / factor) {
+            passCounts.push_back(count);
+        }
+        const QString detail = QString("%1 elements per work-item, %2 passes").arg(factor).arg(passCounts.size());
+        cl_mem resultBuffer = passBuffers[(passCounts.size() - 1) % 2];
+        auto validate = [&](const QString& variant) {
+            cl_uint sum = 0;
+            const cl_int status = _clEnqueueReadBuffer(context.queue, resultBuffer, CL_TRUE, 0, sizeof(cl_uint), &sum, 0, nullptr, nullptr);
+            if (status != CL_SUCCESS) {
+                error = "Could not read reduction result: " + utils::errorString(status);
+                return false;
+            }
+            if (sum != expectedSum) {
+                failedValidations.append(variant + ", " + detail);
+            }
+            return true;
+        };
+
+        BenchmarkTimings hostTimings;
+        const bool hostSuccess = context.timeHost([&]() {
+            for (size_t pass = 0; pass < passCounts.size(); pass++) {
+                cl_mem input = (pass == 0) ? sourceBuffer : passBuffers[(pass - 1) % 2];
+                _clSetKernelArg(reducePassKernel, 0, sizeof(cl_mem), &input);
+                _clSetKernelArg(reducePassKernel, 1, sizeof(cl_mem), &passBuffers[pass % 2]);
+                _clSetKernelArg(reducePassKernel, 2, sizeof(cl_uint), &passCounts[pass]);
+                _clSetKernelArg(reducePassKernel, 3, sizeof(cl_uint), &factor);
+                const size_t globalSize = (passCounts[pass] + factor - 1) / factor;
+                const cl_int status = _clEnqueueNDRangeKernel(context.queue, reducePassKernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr);
+                if (status != CL_SUCCESS) {
+                    return status;
+                }
+            }
+            return _clFinish(context.queue);
+        }, hostTimings, error);
+        if (!hostSuccess || !validate("host")) {
+            return false;
+        }
+
+        const cl_uint count = passCounts[0];
+        _clSetKernelArg(reduceRecursiveKernel, 0, sizeof(cl_mem), &sourceBuffer);
+        _clSetKernelArg(reduceRecursiveKernel, 1, sizeof(cl_mem), &passBuffers[0]);
+        _clSetKernelArg(reduceRecursiveKernel, 2, sizeof(cl_mem), &passBuffers[1]);
+        _clSetKernelArg(reduceRecursiveKernel, 3, sizeof(cl_uint), &count);
+        _clSetKernelArg(reduceRecursiveKernel, 4, sizeof(cl_uint), &factor);
+        _clSetKernelArg(reduceRecursiveKernel, 5, sizeof(cl_command_queue), &deviceQueue);
+        const size_t globalSize = (count + factor - 1) / factor;
+        BenchmarkTimings deviceTimings;
+        const bool deviceSuccess = context.timeHost([&]() {
+            const cl_int status = _clEnqueueNDRangeKernel(context.queue, reduceRecursiveKernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr);
+            return (status == CL_SUCCESS) ? _clFinish(context.queue) : status;
+        }, deviceTimings, error);
+        if (!deviceSuccess || !validate("device-side enqueue")) {
+            return false;
+        }
+
+        const double hostTime = hostTimings.median();
+        const double deviceTime = deviceTimings.median();
+        result.addValue("Reduction, host-driven passes", detail, hostTime / 1000.0, "us");
+        result.addValue("Reduction, device-side enqueue", detail, deviceTime / 1000.0, "us");
+        if (deviceTime > 0.0) {
+            result.addValue("Reduction, device-side enqueue speedup", detail, hostTime / deviceTime, "x");
+        }
+    }
+    context.releaseQueue(deviceQueue);
+
+    // Launch throughput for growing device queue sizes, with the fraction of enqueues rejected because the queue ran full
+    std::vector<cl_uint> queueSizes;
+    for (cl_uint size = std::max(preferredQueueSize / 4, cl_uint(1024)); size < maxQueueSize; size *= 2) {
+        queueSizes.push_back(size);
+    }
+    queueSizes.push_back(maxQueueSize);
+    const size_t parents = sweepParents;
+    const cl_uint children = sweepChildren;
+    _clSetKernelArg(launchKernel, 1, sizeof(cl_uint), &children);
+    for (cl_uint queueSize : queueSizes) {
+        const QString detail = sizeString(queueSize);
+        QString queueError;
+        cl_command_queue sweepQueue = context.createDeviceQueue(queueSize, queueError);
+        if (!sweepQueue) {
+            qWarning() << queueError;
+            continue;
+        }
+        _clSetKernelArg(launchKernel, 2, sizeof(cl_command_queue), &sweepQueue);
+        cl_int status = resetCounters();
+        if (status != CL_SUCCESS) {
+            error = "Could not reset counters: " + utils::errorString(status);
+            return false;
+        }
+        BenchmarkTimings timings;
+        const bool success = context.timeHost([&]() {
+            const cl_int enqueueStatus = _clEnqueueNDRangeKernel(context.queue, launchKernel, 1, nullptr, &parents, nullptr, 0, nullptr, nullptr);
+            return (enqueueStatus == CL_SUCCESS) ? _clFinish(context.queue) : enqueueStatus;
+        }, timings, error);
+        if (!success) {
+            return false;
+        }
+        cl_uint counters[2] = {};
+        status = readCounters(counters);
+        if (status != CL_SUCCESS) {
+            error = "Could not read counters: " + utils::errorString(status);
+            return false;
+        }
+        context.releaseQueue(sweepQueue);
+
+        const double launched = double(counters[0]) / runs;
+        const double attempted = double(sweepParents) * sweepChildren;
+        const double time = timings.median();
+        if (time > 0.0) {
+            result.addValue("Child launch throughput", detail, launched / (time / 1e9), "launches/s");
+        }
+        result.addValue("Rejected child launches", detail, 100.0 * double(counters[1]) / runs / attempted, "%");
+    }
+
+    QStringList messages;
+    if (!rejectedEnqueues.isEmpty()) {
+        messages.append("Device queue rejected enqueues: " + rejectedEnqueues.join(", "));
+    }
+    if (!failedValidations.isEmpty()) {
+        messages.append("Reduction results did not match: " + failedValidations.join(", "));
+    }
+    result.message = messages.join("\n");
+    return true;
+}
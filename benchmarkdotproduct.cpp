@@ -0,0 +1,248 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+enum class DotKind { Unsigned, Signed, Mixed };
+
+struct DotSignedness
+{
+    QString name;
+    // Suffix of the packed built-in functions (e.g. dot_4x8packed_us_int)
+    QString suffix;
+    QString resultType;
+    QString aType;
+    QString bType;
+    DotKind kind;
+};
+
+enum class DotForm { Dot, DotAccSat, Packed, PackedAccSat, Manual, ManualSat };
+
+struct DotFormInfo
+{
+    DotForm form;
+    QString name;
+    QString kernelName;
+    // Manual implementation the form is compared against
+    DotForm reference;
+};
+
+static const DotFormInfo dotForms[] = {
+    { DotForm::Manual, "manual multiply-add", "manual", DotForm::Manual },
+    { DotForm::ManualSat, "manual multiply-add, saturating", "manualSat", DotForm::ManualSat },
+    { DotForm::Dot, "dot", "dot", DotForm::Manual },
+    { DotForm::DotAccSat, "dot_acc_sat", "dotAccSat", DotForm::ManualSat },
+    { DotForm::Packed, "dot_4x8packed", "packed", DotForm::Manual },
+    { DotForm::PackedAccSat, "dot_acc_sat_4x8packed", "packedAccSat", DotForm::ManualSat },
+};
+
+// Independent dot product chains per work item, each dot product depends on the result of the previous one
+static const int dotChains = 8;
+static const int dotUnroll = 8;
+
+// Expression for the next value of a chain, the inputs of each dot product are the bytes of the previous result
+static QString dotExpression(const DotSignedness& signedness, DotForm form, const QString& x)
+{
+    const QString packedFunction = QString("4x8packed_%1_%2").arg(signedness.suffix).arg(signedness.resultType);
+    switch (form) {
+    case DotForm::Dot:
+        return QString("dot(as_%1(%2), mv) + c").arg(signedness.aType).arg(x);
+    case DotForm::DotAccSat:
+        return QString("dot_acc_sat(as_%1(%2), mv, %2)").arg(signedness.aType).arg(x);
+    case DotForm::Packed:
+        return QString("dot_%1(as_uint(%2), mp) + c").arg(packedFunction).arg(x);
+    case DotForm::PackedAccSat:
+        return QString("dot_acc_sat_%1(as_uint(%2), mp, %2)").arg(packedFunction).arg(x);
+    case DotForm::Manual:
+        return QString("manualDot(as_%1(%2), mv) + c").arg(signedness.aType).arg(x);
+    case DotForm::ManualSat:
+        return QString("add_sat(%2, manualDot(as_%1(%2), mv))").arg(signedness.aType).arg(x);
+    }
+    return QString();
+}
+
+static QString generateDotSource(const DotSignedness& signedness, const std::vector<DotForm>& forms)
+{
+    const QString& resultType = signedness.resultType;
+    QString source = "#pragma OPENCL EXTENSION cl_khr_integer_dot_product : enable\n\n";
+    // Fallback without the extension, the compiler may still map this to dot product instructions
+    source += QString("%1 manualDot(%2 a, %3 b)\n{\n").arg(resultType).arg(signedness.aType).arg(signedness.bType);
+    source += QString("    return (%1)a.x * (%1)b.x + (%1)a.y * (%1)b.y + (%1)a.z * (%1)b.z + (%1)a.w * (%1)b.w;\n}\n\n").arg(resultType);
+    for (const DotFormInfo& formInfo : dotForms) {
+        if (std::find(forms.begin(), forms.end(), formInfo.form) == forms.end()) {
+            continue;
+        }
+        source += QString("__kernel void %1(__global %2* output, const uint seed, const int iterations)\n{\n").arg(formInfo.kernelName).arg(resultType);
+        // Values depend on kernel arguments and ids, so nothing can be folded at compile time
+        source += QString("    const %1 mv = as_%1(seed);\n").arg(signedness.bType);
+        source += "    const uint mp = seed;\n";
+        source += QString("    const %1 c = (%1)(get_local_id(0) & 1);\n").arg(resultType);
+        for (int chain = 0; chain < dotChains; chain++) {
+            source += QString("    %1 x%2 = (%1)(seed + get_global_id(0) + %2);\n").arg(resultType).arg(chain);
+        }
+        source += "    for (int i = 0; i < iterations; i++) {\n";
+        for (int unroll = 0; unroll < dotUnroll; unroll++) {
+            for (int chain = 0; chain < dotChains; chain++) {
+                const QString x = QString("x%1").arg(chain);
+                source += QString("        %1 = %2;\n").arg(x).arg(dotExpression(signedness, formInfo.form, x));
+            }
+        }
+        source += "    }\n";
+        source += "    output[get_global_id(0)] = x0";
+        for (int chain = 1; chain < dotChains; chain++) {
+            source += QString(" + x%1").arg(chain);
+        }
+        source += ";\n}\n\n";
+    }
+    return source;
+}
+
+static bool reportedAccelerated(const cl_device_integer_dot_product_acceleration_properties_khr& properties, DotKind kind, bool saturating)
+{
+    switch (kind) {
+    case DotKind::Unsigned:
+        return saturating ? properties.accumulating_saturating_unsigned_accelerated : properties.unsigned_accelerated;
+    case DotKind::Signed:
+        return saturating ? properties.accumulating_saturating_signed_accelerated : properties.signed_accelerated;
+    case DotKind::Mixed:
+        return saturating ? properties.accumulating_saturating_mixed_signedness_accelerated : properties.mixed_signedness_accelerated;
+    }
+    return false;
+}
+
+bool DotProductBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (!context.device.extensionSupported("cl_khr_integer_dot_product")) {
+        reason = "Device does not support cl_khr_integer_dot_product";
+        return false;
+    }
+    return true;
+}
+
+bool DotProductBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const std::vector<DotSignedness> signednesses = {
+        { "unsigned", "uu", "uint", "uchar4", "uchar4", DotKind::Unsigned },
+        { "signed", "ss", "int", "char4", "char4", DotKind::Signed },
+        { "unsigned x signed", "us", "int", "uchar4", "char4", DotKind::Mixed },
+        { "signed x unsigned", "su", "int", "char4", "uchar4", DotKind::Mixed },
+    };
+
+    const cl_device_integer_dot_product_capabilities_khr capabilities = context.deviceValue<cl_device_integer_dot_product_capabilities_khr>(CL_DEVICE_INTEGER_DOT_PRODUCT_CAPABILITIES_KHR);
+    const cl_device_integer_dot_product_acceleration_properties_khr properties8Bit = context.deviceValue<cl_device_integer_dot_product_acceleration_properties_khr>(CL_DEVICE_INTEGER_DOT_PRODUCT_ACCELERATION_PROPERTIES_8BIT_KHR);
+    const cl_device_integer_dot_product_acceleration_properties_khr propertiesPacked = context.deviceValue<cl_device_integer_dot_product_acceleration_properties_khr>(CL_DEVICE_INTEGER_DOT_PRODUCT_ACCELERATION_PROPERTIES_4x8BIT_PACKED_KHR);
+    std::vector<DotForm> forms = { DotForm::Manual, DotForm::ManualSat };
+    if (capabilities & CL_DEVICE_INTEGER_DOT_PRODUCT_INPUT_4x8BIT_KHR) {
+        forms.push_back(DotForm::Dot);
+        forms.push_back(DotForm::DotAccSat);
+    }
+    if (capabilities & CL_DEVICE_INTEGER_DOT_PRODUCT_INPUT_4x8BIT_PACKED_KHR) {
+        forms.push_back(DotForm::Packed);
+        forms.push_back(DotForm::PackedAccSat);
+    }
+    QString languageVersion;
+    if (context.device.clVersionMajor >= 3) {
+        languageVersion = "-cl-std=CL3.0";
+    } else if (context.device.clVersionMajor == 2) {
+        languageVersion = "-cl-std=CL2.0";
+    }
+
+    const cl_uint computeUnits = std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_WRITE_ONLY, size_t(256) * computeUnits * 8 * sizeof(cl_uint), nullptr, error);
+    if (!outputBuffer) {
+        return false;
+    }
+
+    QStringList notAccelerated;
+    QStringList failedBuilds;
+    for (auto& signedness : signednesses) {
+        cl_program program = context.buildProgram(generateDotSource(signedness, forms), languageVersion, error);
+        if (!program) {
+            // Advertised but not supported by the compiler, keep going with the other signedness combinations
+            qWarning() << "Could not build dot product program for" << signedness.name << ":" << error;
+            failedBuilds.append(signedness.name);
+            continue;
+        }
+        std::unordered_map<int, double> throughputs;
+        for (const DotFormInfo& formInfo : dotForms) {
+            if (std::find(forms.begin(), forms.end(), formInfo.form) == forms.end()) {
+                continue;
+            }
+            cl_kernel kernel = context.createKernel(program, formInfo.kernelName.toLatin1().constData(), error);
+            if (!kernel) {
+                return false;
+            }
+            // Work group size is a multiple of the preferred multiple, with enough groups to fill all compute units several times
+            size_t preferredMultiple = 1;
+            size_t maxWorkGroupSize = 1;
+            _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, sizeof(size_t), &preferredMultiple, nullptr);
+            _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxWorkGroupSize, nullptr);
+            preferredMultiple = std::max(preferredMultiple, size_t(1));
+            size_t localSize = std::min(maxWorkGroupSize, size_t(256));
+            localSize = std::max(localSize - (localSize % preferredMultiple), std::min(preferredMultiple, maxWorkGroupSize));
+            const size_t globalSize = localSize * computeUnits * 8;
+
+            const cl_uint seed = 0x01020304;
+            _clSetKernelArg(kernel, 0, sizeof(cl_mem), &outputBuffer);
+            _clSetKernelArg(kernel, 1, sizeof(cl_uint), &seed);
+            cl_int iterations = 0;
+            if (!calibrateIterations(context, kernel, 2, globalSize, localSize, iterations, error)) {
+                return false;
+            }
+            BenchmarkTimings timings;
+            if (!context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error)) {
+                return false;
+            }
+            // Each dot product of four 8-bit pairs counts as four multiplies and four additions
+            const double operations = 8.0 * globalSize * double(iterations) * dotChains * dotUnroll;
+            const double throughput = (timings.median() > 0.0) ? operations / timings.median() : 0.0;
+            throughputs[int(formInfo.form)] = throughput;
+
+            QString detail = formInfo.name;
+            const bool builtIn = (formInfo.form != DotForm::Manual) && (formInfo.form != DotForm::ManualSat);
+            if (builtIn) {
+                const bool packed = (formInfo.form == DotForm::Packed) || (formInfo.form == DotForm::PackedAccSat);
+                const bool saturating = (formInfo.reference == DotForm::ManualSat);
+                const bool accelerated = reportedAccelerated(packed ? propertiesPacked : properties8Bit, signedness.kind, saturating);
+                detail += accelerated ? ", reported accelerated" : ", not reported accelerated";
+                result.addValue("Dot product " + signedness.name, detail, throughput, "GIOPS");
+                const double reference = throughputs[int(formInfo.reference)];
+                if (reference > 0.0) {
+                    result.addValue("Dot product " + signedness.name, formInfo.name + ", relative to manual", throughput / reference, "x");
+                    // Acceleration should at least be noticeable against plain multiply-adds
+                    if (accelerated && (throughput < reference * 1.1)) {
+                        notAccelerated.append(signedness.name + " " + formInfo.name);
+                    }
+                }
+            } else {
+                result.addValue("Dot product " + signedness.name, detail, throughput, "GIOPS");
+            }
+        }
+    }
+    QStringList notes;
+    if (!notAccelerated.isEmpty()) {
+        notes.append("Reported accelerated but not faster than manual multiply-add: " + notAccelerated.join(", "));
+    }
+    if (!failedBuilds.isEmpty()) {
+        notes.append("Could not be built: " + failedBuilds.join(", "));
+    }
+    result.message = notes.join("; ");
+    return true;
+}
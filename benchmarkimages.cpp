@@ -0,0 +1,383 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <map>
+#include <tuple>
+#include <string>
+#include <iterator>
+
+// Each work item reads or writes a column of pixels, so the number of work items stays reasonable for large images
+static const char* imageSource = R"(
+#if NORMALIZED_COORDS
+#define COORDS_MODE CLK_NORMALIZED_COORDS_TRUE
+#else
+#define COORDS_MODE CLK_NORMALIZED_COORDS_FALSE
+#endif
+#if LINEAR_FILTER
+#define FILTER_MODE CLK_FILTER_LINEAR
+#else
+#define FILTER_MODE CLK_FILTER_NEAREST
+#endif
+
+__constant sampler_t sampler = COORDS_MODE | CLK_ADDRESS_CLAMP_TO_EDGE | FILTER_MODE;
+
+__kernel void readImage(__read_only image2d_t image, __global DATA_TYPE* output, const uint writeIndex)
+{
+    const int x = get_global_id(0);
+    const int y0 = get_global_id(1) * ROWS_PER_ITEM;
+    const float2 scale = NORMALIZED_COORDS ? (float2)(1.0f / get_image_width(image), 1.0f / get_image_height(image)) : (float2)(1.0f, 1.0f);
+    DATA_TYPE sum = (DATA_TYPE)(0);
+    for (int y = y0; y < y0 + ROWS_PER_ITEM; y++) {
+        sum += READ_IMAGE(image, sampler, ((float2)((float)x, (float)y) + 0.5f) * scale);
+    }
+    // Never true, but keeps the compiler from removing the reads
+    if (get_global_id(1) * get_global_size(0) + x == writeIndex) {
+        output[0] = sum;
+    }
+}
+
+__kernel void writeImage(__write_only image2d_t image)
+{
+    const int x = get_global_id(0);
+    const int y0 = get_global_id(1) * ROWS_PER_ITEM;
+    for (int y = y0; y < y0 + ROWS_PER_ITEM; y++) {
+        WRITE_IMAGE(image, (int2)(x, y), (DATA_TYPE)(x & 1));
+    }
+}
+)";
+
+// Same access pattern on a linear buffer with elements of the image's pixel size
+static const char* bufferSource = R"(
+__kernel void readBuffer(__global const ELEMENT_TYPE* input, __global ELEMENT_TYPE* output, const uint writeIndex)
+{
+    const int x = get_global_id(0);
+    const int width = get_global_size(0);
+    const int y0 = get_global_id(1) * ROWS_PER_ITEM;
+    ELEMENT_TYPE sum = (ELEMENT_TYPE)(0);
+    for (int y = y0; y < y0 + ROWS_PER_ITEM; y++) {
+        sum += input[y * width + x];
+    }
+    if (get_global_id(1) * get_global_size(0) + x == writeIndex) {
+        output[0] = sum;
+    }
+}
+
+__kernel void writeBuffer(__global ELEMENT_TYPE* output)
+{
+    const int x = get_global_id(0);
+    const int width = get_global_size(0);
+    const int y0 = get_global_id(1) * ROWS_PER_ITEM;
+    for (int y = y0; y < y0 + ROWS_PER_ITEM; y++) {
+        output[y * width + x] = (ELEMENT_TYPE)(x & 1);
+    }
+}
+)";
+
+static const cl_uint rowsPerItem = 16;
+
+// Image read and write built-ins used for a channel data type
+enum class ImageAccessType { Float, Int, UnsignedInt };
+
+struct ImageAccess
+{
+    const char* dataType;
+    const char* readFunction;
+    const char* writeFunction;
+};
+
+static const std::map<ImageAccessType, ImageAccess> imageAccesses = {
+    { ImageAccessType::Float, { "float4", "read_imagef", "write_imagef" } },
+    { ImageAccessType::Int, { "int4", "read_imagei", "write_imagei" } },
+    { ImageAccessType::UnsignedInt, { "uint4", "read_imageui", "write_imageui" } },
+};
+
+struct SamplerMode
+{
+    QString name;
+    bool normalizedCoords;
+    bool linearFilter;
+};
+
+// Integer images can only be read with unnormalized coordinates and nearest filtering, so only the first mode applies to them
+static const SamplerMode samplerModes[] = {
+    { "nearest, unnormalized", false, false },
+    { "nearest, normalized", true, false },
+    { "linear, unnormalized", false, true },
+    { "linear, normalized", true, true },
+};
+
+static const std::map<size_t, const char*> bufferElementTypes = {
+    { 1, "uchar" },
+    { 2, "ushort" },
+    { 4, "uint" },
+    { 8, "uint2" },
+    { 16, "uint4" },
+};
+
+// Size of a single pixel in bytes, zero for formats that are not benchmarked (e.g. depth and padded formats)
+static size_t pixelSize(const cl_image_format& format)
+{
+    switch (format.image_channel_data_type) {
+    case CL_UNORM_SHORT_565:
+    case CL_UNORM_SHORT_555:
+        return 2;
+    case CL_UNORM_INT_101010:
+    case CL_UNORM_INT_101010_2:
+        return 4;
+    }
+    size_t channels = 0;
+    switch (format.image_channel_order) {
+    case CL_R:
+    case CL_A:
+    case CL_INTENSITY:
+    case CL_LUMINANCE:
+        channels = 1;
+        break;
+    case CL_RG:
+    case CL_RA:
+        channels = 2;
+        break;
+    case CL_RGB:
+    case CL_sRGB:
+        channels = 3;
+        break;
+    case CL_RGBA:
+    case CL_BGRA:
+    case CL_ARGB:
+    case CL_ABGR:
+    case CL_sRGBA:
+    case CL_sBGRA:
+        channels = 4;
+        break;
+    }
+    switch (format.image_channel_data_type) {
+    case CL_SNORM_INT8:
+    case CL_UNORM_INT8:
+    case CL_SIGNED_INT8:
+    case CL_UNSIGNED_INT8:
+        return channels;
+    case CL_SNORM_INT16:
+    case CL_UNORM_INT16:
+    case CL_SIGNED_INT16:
+    case CL_UNSIGNED_INT16:
+    case CL_HALF_FLOAT:
+        return channels * 2;
+    case CL_SIGNED_INT32:
+    case CL_UNSIGNED_INT32:
+    case CL_FLOAT:
+        return channels * 4;
+    }
+    return 0;
+}
+
+static ImageAccessType imageAccessType(cl_channel_type channelType)
+{
+    switch (channelType) {
+    case CL_SIGNED_INT8:
+    case CL_SIGNED_INT16:
+    case CL_SIGNED_INT32:
+        return ImageAccessType::Int;
+    case CL_UNSIGNED_INT8:
+    case CL_UNSIGNED_INT16:
+    case CL_UNSIGNED_INT32:
+        return ImageAccessType::UnsignedInt;
+    }
+    return ImageAccessType::Float;
+}
+
+QString ImageBenchmark::formatName(const cl_image_format& format)
+{
+    return utils::channelOrderString(format.image_channel_order) + " " + utils::channelTypeString(format.image_channel_data_type);
+}
+
+bool ImageBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (!context.deviceValue<cl_bool>(CL_DEVICE_IMAGE_SUPPORT)) {
+        reason = "Device does not support images";
+        return false;
+    }
+    return true;
+}
+
+bool ImageBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // 2D image formats from the supported format matrix, sorted so results are listed in a stable order
+    std::vector<std::pair<cl_image_format, cl_mem_flags>> formats;
+    auto imageType = context.device.imageTypes.find(CL_MEM_OBJECT_IMAGE2D);
+    if (imageType != context.device.imageTypes.end()) {
+        for (auto& channelOrder : imageType->second.channelOrders) {
+            for (auto& channelType : channelOrder.second.channelTypes) {
+                const cl_image_format format = { channelOrder.first, channelType.first };
+                if (pixelSize(format) > 0) {
+                    formats.push_back({ format, channelType.second.memFlags });
+                }
+            }
+        }
+    }
+    std::sort(formats.begin(), formats.end(), [](const auto& a, const auto& b) {
+        return std::make_pair(a.first.image_channel_order, a.first.image_channel_data_type) < std::make_pair(b.first.image_channel_order, b.first.image_channel_data_type);
+    });
+    if (formats.empty()) {
+        result.message = "No supported 2D image formats";
+        return true;
+    }
+
+    size_t width = std::min(context.deviceValue<size_t>(CL_DEVICE_IMAGE2D_MAX_WIDTH), size_t(2048));
+    size_t height = std::min(context.deviceValue<size_t>(CL_DEVICE_IMAGE2D_MAX_HEIGHT), size_t(2048));
+    // Largest pixels are 16 bytes
+    while ((width * height * 16 > context.maxBufferSize()) && (height > rowsPerItem)) {
+        height /= 2;
+    }
+    height -= height % rowsPerItem;
+    const size_t globalSize[2] = { width, height / rowsPerItem };
+    const cl_uint writeIndex = 0xFFFFFFFF;
+
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_WRITE_ONLY, 16, nullptr, error);
+    if (!outputBuffer) {
+        return false;
+    }
+
+    // Programs and kernels are shared by all formats with the same access type and sampler mode
+    std::map<std::pair<ImageAccessType, size_t>, cl_program> imagePrograms;
+    std::map<std::tuple<ImageAccessType, size_t, std::string>, cl_kernel> imageKernels;
+    auto imageKernel = [&](ImageAccessType accessType, size_t samplerMode, const char* name) -> cl_kernel {
+        cl_kernel& kernel = imageKernels[{ accessType, samplerMode, name }];
+        if (kernel) {
+            return kernel;
+        }
+        cl_program& program = imagePrograms[{ accessType, samplerMode }];
+        if (!program) {
+            const ImageAccess& access = imageAccesses.at(accessType);
+            const QString options = QString("-DDATA_TYPE=%1 -DREAD_IMAGE=%2 -DWRITE_IMAGE=%3 -DNORMALIZED_COORDS=%4 -DLINEAR_FILTER=%5 -DROWS_PER_ITEM=%6")
+                .arg(access.dataType).arg(access.readFunction).arg(access.writeFunction)
+                .arg(samplerModes[samplerMode].normalizedCoords ? 1 : 0).arg(samplerModes[samplerMode].linearFilter ? 1 : 0).arg(rowsPerItem);
+            program = context.buildProgram(imageSource, options, error);
+            if (!program) {
+                return nullptr;
+            }
+        }
+        kernel = context.createKernel(program, name, error);
+        return kernel;
+    };
+
+    // Buffer throughput per pixel size, for comparison with the image formats of the same size
+    std::map<size_t, double> bufferReadThroughput;
+    for (auto& elementType : bufferElementTypes) {
+        const size_t bufferSize = width * height * elementType.first;
+        cl_program program = context.buildProgram(bufferSource, QString("-DELEMENT_TYPE=%1 -DROWS_PER_ITEM=%2").arg(elementType.second).arg(rowsPerItem), error);
+        if (!program) {
+            return false;
+        }
+        cl_kernel readKernel = context.createKernel(program, "readBuffer", error);
+        cl_kernel writeKernel = context.createKernel(program, "writeBuffer", error);
+        cl_mem buffer = context.createBuffer(CL_MEM_READ_WRITE, bufferSize, nullptr, error);
+        if (!readKernel || !writeKernel || !buffer) {
+            return false;
+        }
+        _clSetKernelArg(readKernel, 0, sizeof(cl_mem), &buffer);
+        _clSetKernelArg(readKernel, 1, sizeof(cl_mem), &outputBuffer);
+        _clSetKernelArg(readKernel, 2, sizeof(cl_uint), &writeIndex);
+        _clSetKernelArg(writeKernel, 0, sizeof(cl_mem), &buffer);
+        BenchmarkTimings readTimings;
+        BenchmarkTimings writeTimings;
+        if (!context.timeKernel(writeKernel, 2, globalSize, nullptr, writeTimings, error) || !context.timeKernel(readKernel, 2, globalSize, nullptr, readTimings, error)) {
+            return false;
+        }
+        context.releaseBuffer(buffer);
+        const QString detail = QString("%1 byte elements").arg(elementType.first);
+        bufferReadThroughput[elementType.first] = (readTimings.median() > 0.0) ? bufferSize / readTimings.median() : 0.0;
+        result.addValue("Buffer read", detail, bufferReadThroughput[elementType.first], "GB/s");
+        result.addValue("Buffer write", detail, (writeTimings.median() > 0.0) ? bufferSize / writeTimings.median() : 0.0, "GB/s");
+    }
+
+    QStringList failedFormats;
+    for (auto& entry : formats) {
+        const cl_image_format& format = entry.first;
+        const cl_mem_flags memFlags = entry.second;
+        const QString name = formatName(format);
+        const size_t imageSize = width * height * pixelSize(format);
+        const ImageAccessType accessType = imageAccessType(format.image_channel_data_type);
+
+        // Images supported as read/write can be used for both, otherwise separate images are created for reading and writing
+        cl_mem readImage = nullptr;
+        cl_mem writeImage = nullptr;
+        if (memFlags & CL_MEM_READ_WRITE) {
+            readImage = writeImage = context.createImage2D(CL_MEM_READ_WRITE, format, width, height, error);
+        } else {
+            if (memFlags & CL_MEM_READ_ONLY) {
+                readImage = context.createImage2D(CL_MEM_READ_ONLY, format, width, height, error);
+            }
+            if (memFlags & CL_MEM_WRITE_ONLY) {
+                writeImage = context.createImage2D(CL_MEM_WRITE_ONLY, format, width, height, error);
+            }
+        }
+        if (!readImage && !writeImage) {
+            qWarning() << "Could not create image with format" << name << ":" << error;
+            failedFormats.append(name);
+            continue;
+        }
+
+        if (writeImage) {
+            cl_kernel kernel = imageKernel(accessType, 0, "writeImage");
+            if (!kernel) {
+                return false;
+            }
+            _clSetKernelArg(kernel, 0, sizeof(cl_mem), &writeImage);
+            BenchmarkTimings timings;
+            if (!context.timeKernel(kernel, 2, globalSize, nullptr, timings, error)) {
+                return false;
+            }
+            result.addValue(name, "write", (timings.median() > 0.0) ? imageSize / timings.median() : 0.0, "GB/s");
+        }
+
+        if (readImage) {
+            const size_t modeCount = (accessType == ImageAccessType::Float) ? std::size(samplerModes) : 1;
+            for (size_t mode = 0; mode < modeCount; mode++) {
+                cl_kernel kernel = imageKernel(accessType, mode, "readImage");
+                if (!kernel) {
+                    return false;
+                }
+                _clSetKernelArg(kernel, 0, sizeof(cl_mem), &readImage);
+                _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+                _clSetKernelArg(kernel, 2, sizeof(cl_uint), &writeIndex);
+                BenchmarkTimings timings;
+                if (!context.timeKernel(kernel, 2, globalSize, nullptr, timings, error)) {
+                    return false;
+                }
+                const double throughput = (timings.median() > 0.0) ? imageSize / timings.median() : 0.0;
+                result.addValue(name, "sampler read, " + samplerModes[mode].name, throughput, "GB/s");
+                auto bufferThroughput = bufferReadThroughput.find(pixelSize(format));
+                if ((mode == 0) && (bufferThroughput != bufferReadThroughput.end()) && (bufferThroughput->second > 0.0)) {
+                    result.addValue(name, "read relative to buffer", throughput / bufferThroughput->second, "x");
+                }
+            }
+        }
+
+        context.releaseBuffer(readImage);
+        if (writeImage != readImage) {
+            context.releaseBuffer(writeImage);
+        }
+    }
+    if (!failedFormats.isEmpty()) {
+        result.message = "Could not create images for " + failedFormats.join(", ");
+    }
+    return true;
+}
@@ -0,0 +1,189 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <atomic>
+#include <thread>
+
+static const char* emptyKernelSource = R"(
+__kernel void empty()
+{
+}
+)";
+
+struct CallbackState
+{
+    std::atomic<bool> fired{ false };
+    std::chrono::steady_clock::time_point time;
+};
+
+static void CL_CALLBACK eventCompleteCallback(cl_event event, cl_int status, void* userData)
+{
+    (void)event;
+    (void)status;
+    CallbackState* state = static_cast<CallbackState*>(userData);
+    state->time = std::chrono::steady_clock::now();
+    state->fired.store(true, std::memory_order_release);
+}
+
+static double elapsedNanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// Latencies are usually long tailed, so percentiles are reported instead of the mean
+static void addPercentiles(BenchmarkResult& result, const QString& name, const BenchmarkTimings& timings)
+{
+    result.addValue(name, "min", timings.min() / 1000.0, "us");
+    result.addValue(name, "p50", timings.percentile(50.0) / 1000.0, "us");
+    result.addValue(name, "p90", timings.percentile(90.0) / 1000.0, "us");
+    result.addValue(name, "p99", timings.percentile(99.0) / 1000.0, "us");
+}
+
+bool LatencyBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    cl_program program = context.buildProgram(emptyKernelSource, "", error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel kernel = context.createKernel(program, "empty", error);
+    if (!kernel) {
+        return false;
+    }
+
+    std::vector<std::pair<QString, cl_command_queue>> queues = { { "In-order", context.queue } };
+    const cl_command_queue_properties queueProperties = context.deviceValue<cl_command_queue_properties>(CL_DEVICE_QUEUE_PROPERTIES);
+    if (queueProperties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) {
+        cl_command_queue outOfOrderQueue = context.createQueue(CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, error);
+        if (!outOfOrderQueue) {
+            return false;
+        }
+        queues.push_back({ "Out-of-order", outOfOrderQueue });
+    }
+
+    // Percentiles need more samples than the other benchmarks
+    const uint32_t sampleCount = std::max(context.settings.iterations, 200u);
+    const uint32_t warmupCount = context.settings.warmupIterations;
+    const size_t globalSize = 1;
+
+    for (auto& queue : queues) {
+        const QString& queueName = queue.first;
+        cl_command_queue commandQueue = queue.second;
+        BenchmarkTimings enqueueTimings;
+        BenchmarkTimings finishTimings;
+        BenchmarkTimings queuedToStartTimings;
+        BenchmarkTimings startToEndTimings;
+        BenchmarkTimings callbackTimings;
+
+        // Single dispatches waited for with clFinish
+        for (uint32_t i = 0; i < warmupCount + sampleCount; i++) {
+            cl_event event = nullptr;
+            const auto start = std::chrono::steady_clock::now();
+            cl_int status = _clEnqueueNDRangeKernel(commandQueue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, &event);
+            const auto enqueued = std::chrono::steady_clock::now();
+            if (status != CL_SUCCESS) {
+                error = "Could not enqueue kernel: " + utils::errorString(status);
+                return false;
+            }
+            status = _clFinish(commandQueue);
+            const auto finished = std::chrono::steady_clock::now();
+            if ((status == CL_SUCCESS) && (i >= warmupCount)) {
+                cl_ulong queued = 0;
+                cl_ulong started = 0;
+                cl_ulong ended = 0;
+                _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &queued, nullptr);
+                _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &started, nullptr);
+                _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &ended, nullptr);
+                enqueueTimings.samples.push_back(elapsedNanoseconds(start, enqueued));
+                finishTimings.samples.push_back(elapsedNanoseconds(start, finished));
+                queuedToStartTimings.samples.push_back((started > queued) ? double(started - queued) : 0.0);
+                startToEndTimings.samples.push_back((ended > started) ? double(ended - started) : 0.0);
+            }
+            _clReleaseEvent(event);
+            if (status != CL_SUCCESS) {
+                error = "Could not finish queue: " + utils::errorString(status);
+                return false;
+            }
+        }
+
+        // Single dispatches waited for with an event callback instead of blocking the host thread
+        for (uint32_t i = 0; i < warmupCount + sampleCount; i++) {
+            CallbackState state;
+            cl_event event = nullptr;
+            const auto start = std::chrono::steady_clock::now();
+            cl_int status = _clEnqueueNDRangeKernel(commandQueue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, &event);
+            if (status == CL_SUCCESS) {
+                status = _clSetEventCallback(event, CL_COMPLETE, eventCompleteCallback, &state);
+            }
+            if (status != CL_SUCCESS) {
+                if (event) {
+                    _clFinish(commandQueue);
+                    _clReleaseEvent(event);
+                }
+                error = "Could not set up event callback: " + utils::errorString(status);
+                return false;
+            }
+            _clFlush(commandQueue);
+            while (!state.fired.load(std::memory_order_acquire)) {
+                if (elapsedNanoseconds(start, std::chrono::steady_clock::now()) > 10e9) {
+                    // The callback still references the state, so it can't go out of scope before the command completes
+                    _clFinish(commandQueue);
+                    while (!state.fired.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    _clReleaseEvent(event);
+                    error = "Event callback was not called within 10 seconds";
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            if (i >= warmupCount) {
+                callbackTimings.samples.push_back(elapsedNanoseconds(start, state.time));
+            }
+            _clReleaseEvent(event);
+        }
+
+        addPercentiles(result, queueName + " enqueue", enqueueTimings);
+        addPercentiles(result, queueName + " queued to start", queuedToStartTimings);
+        addPercentiles(result, queueName + " start to end", startToEndTimings);
+        addPercentiles(result, queueName + " clFinish round trip", finishTimings);
+        addPercentiles(result, queueName + " event callback round trip", callbackTimings);
+
+        // Batches of small dispatches submitted back to back with a single clFinish
+        for (uint32_t batchSize : { 10u, 100u, 1000u }) {
+            BenchmarkTimings batchTimings;
+            const bool batchSuccess = context.timeHost([&]() {
+                for (uint32_t i = 0; i < batchSize; i++) {
+                    const cl_int status = _clEnqueueNDRangeKernel(commandQueue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr);
+                    if (status != CL_SUCCESS) {
+                        return status;
+                    }
+                }
+                return _clFinish(commandQueue);
+            }, batchTimings, error);
+            if (!batchSuccess) {
+                return false;
+            }
+            const double dispatchesPerSecond = (batchTimings.median() > 0.0) ? batchSize / (batchTimings.median() / 1e9) : 0.0;
+            result.addValue(queueName + " batch throughput", QString("%1 dispatches").arg(batchSize), dispatchesPerSecond, "dispatches/s");
+        }
+    }
+    return true;
+}
@@ -0,0 +1,281 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// TILE_SIZE (power of two) and CHASE_SIZE are passed as build options
+static const char* localMemorySource = R"(
+// Each work item follows four independent index chains through local memory,
+// neighbouring work items are stride elements apart, so the stride determines the number of bank conflicts
+__kernel void localStride(__global uint* output, const uint stride, const int iterations)
+{
+    __local uint tile[TILE_SIZE];
+    const uint lid = get_local_id(0);
+    const uint localSize = get_local_size(0);
+    for (uint i = lid; i < TILE_SIZE; i += localSize) {
+        tile[i] = i;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    const uint mask = TILE_SIZE - 1;
+    const uint step = localSize * stride;
+    uint i0 = (lid * stride) & mask;
+    uint i1 = (i0 + TILE_SIZE / 4) & mask;
+    uint i2 = (i0 + TILE_SIZE / 2) & mask;
+    uint i3 = (i0 + 3 * TILE_SIZE / 4) & mask;
+    for (int i = 0; i < iterations; i++) {
+        // tile[n] == n, the loads can't be hoisted as each index depends on the previous load
+        i0 = (tile[i0] + step) & mask;
+        i1 = (tile[i1] + step) & mask;
+        i2 = (tile[i2] + step) & mask;
+        i3 = (tile[i3] + step) & mask;
+    }
+    output[get_global_id(0)] = i0 + i1 + i2 + i3;
+}
+
+__kernel void barrierCost(__global uint* output, const int iterations)
+{
+    __local uint tile[1024];
+    const uint lid = get_local_id(0);
+    const uint localSize = get_local_size(0);
+    uint value = lid;
+    for (int i = 0; i < iterations; i++) {
+        tile[lid] = value;
+#if USE_BARRIER
+        barrier(CLK_LOCAL_MEM_FENCE);
+#endif
+        // Without barriers this read races with the neighbour's write, which is fine for a timing baseline
+        value += tile[(lid + 1) % localSize];
+#if USE_BARRIER
+        barrier(CLK_LOCAL_MEM_FENCE);
+#endif
+    }
+    output[get_global_id(0)] = value;
+}
+
+// Single work item pointer chases, the chain is a random cycle so every load depends on the previous one
+__kernel void chaseLocal(__global const uint* chain, __global uint* output, const int steps)
+{
+    __local uint tile[CHASE_SIZE];
+    for (uint i = get_local_id(0); i < CHASE_SIZE; i += get_local_size(0)) {
+        tile[i] = chain[i];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (get_local_id(0) == 0) {
+        uint index = 0;
+        for (int i = 0; i < steps; i++) {
+            index = tile[index];
+        }
+        output[0] = index;
+    }
+}
+
+__kernel void chaseGlobal(__global const uint* chain, __global uint* output, const int steps)
+{
+    if (get_local_id(0) == 0) {
+        uint index = 0;
+        for (int i = 0; i < steps; i++) {
+            index = chain[index];
+        }
+        output[0] = index;
+    }
+}
+)";
+
+// Returns the average time per step of a pointer chase, with the fixed cost (e.g. copying to local memory) removed
+static bool chaseLatency(BenchmarkContext& context, cl_kernel kernel, cl_mem chainBuffer, cl_mem outputBuffer, size_t localSize, double& latency, QString& error)
+{
+    const cl_int steps = 65536;
+    const cl_int noSteps = 0;
+    _clSetKernelArg(kernel, 0, sizeof(cl_mem), &chainBuffer);
+    _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+    BenchmarkTimings baseTimings;
+    BenchmarkTimings chaseTimings;
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &noSteps);
+    if (!context.timeKernel(kernel, 1, &localSize, &localSize, baseTimings, error)) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &steps);
+    if (!context.timeKernel(kernel, 1, &localSize, &localSize, chaseTimings, error)) {
+        return false;
+    }
+    latency = std::max(chaseTimings.median() - baseTimings.median(), 0.0) / steps;
+    return true;
+}
+
+bool LocalMemoryBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (context.deviceValue<cl_device_local_mem_type>(CL_DEVICE_LOCAL_MEM_TYPE) == CL_NONE) {
+        reason = "Device has no local memory";
+        return false;
+    }
+    return true;
+}
+
+bool LocalMemoryBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // Local memory tile of at most 16 KiB, half of the available local memory is left for the implementation
+    const cl_ulong localMemorySize = context.deviceValue<cl_ulong>(CL_DEVICE_LOCAL_MEM_SIZE);
+    cl_uint tileSize = 4096;
+    while ((tileSize * sizeof(cl_uint) > localMemorySize / 2) && (tileSize > 64)) {
+        tileSize /= 2;
+    }
+    const cl_uint chaseSize = tileSize;
+    const QString options = QString("-DTILE_SIZE=%1 -DCHASE_SIZE=%2").arg(tileSize).arg(chaseSize);
+    cl_program program = context.buildProgram(localMemorySource, options + " -DUSE_BARRIER=1", error);
+    cl_program programWithoutBarriers = context.buildProgram(localMemorySource, options + " -DUSE_BARRIER=0", error);
+    if (!program || !programWithoutBarriers) {
+        return false;
+    }
+    cl_kernel strideKernel = context.createKernel(program, "localStride", error);
+    cl_kernel barrierKernel = context.createKernel(program, "barrierCost", error);
+    cl_kernel noBarrierKernel = context.createKernel(programWithoutBarriers, "barrierCost", error);
+    cl_kernel chaseLocalKernel = context.createKernel(program, "chaseLocal", error);
+    cl_kernel chaseGlobalKernel = context.createKernel(program, "chaseGlobal", error);
+    if (!strideKernel || !barrierKernel || !noBarrierKernel || !chaseLocalKernel || !chaseGlobalKernel) {
+        return false;
+    }
+
+    const cl_uint computeUnits = std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+    size_t localSize = 1;
+    _clGetKernelWorkGroupInfo(strideKernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &localSize, nullptr);
+    localSize = std::min(localSize, size_t(256));
+    result.addValue("Tile size", double(tileSize * sizeof(cl_uint)) / 1024.0, "KiB");
+    result.addValue("Work group size", double(localSize), "");
+
+    // Enough work groups to keep all compute units busy
+    const size_t globalSize = localSize * computeUnits * 4;
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_WRITE_ONLY, globalSize * sizeof(cl_uint), nullptr, error);
+    if (!outputBuffer) {
+        return false;
+    }
+
+    // Bandwidth versus stride
+    const cl_int strideIterations = 1024;
+    _clSetKernelArg(strideKernel, 0, sizeof(cl_mem), &outputBuffer);
+    _clSetKernelArg(strideKernel, 2, sizeof(cl_int), &strideIterations);
+    std::vector<std::pair<cl_uint, double>> bandwidths;
+    for (cl_uint stride : { 1u, 2u, 3u, 4u, 5u, 8u, 9u, 16u, 17u, 32u, 33u, 64u, 65u }) {
+        _clSetKernelArg(strideKernel, 1, sizeof(cl_uint), &stride);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(strideKernel, 1, &globalSize, &localSize, timings, error)) {
+            return false;
+        }
+        const double bytes = double(globalSize) * strideIterations * 4 * sizeof(cl_uint);
+        const double bandwidth = (timings.median() > 0.0) ? bytes / timings.median() : 0.0;
+        bandwidths.push_back({ stride, bandwidth });
+        result.addValue("Local bandwidth", QString("stride %1").arg(stride), bandwidth, "GB/s");
+    }
+
+    // With n banks a power of two stride s causes min(s, n) way conflicts, so bandwidth halves with every
+    // doubling of the stride until the stride reaches the bank count and stays flat afterwards
+    const double unitStrideBandwidth = bandwidths[0].second;
+    double worstBandwidth = unitStrideBandwidth;
+    cl_uint worstStride = 1;
+    for (auto& bandwidth : bandwidths) {
+        if ((bandwidth.second > 0.0) && (bandwidth.second < worstBandwidth)) {
+            worstBandwidth = bandwidth.second;
+            worstStride = bandwidth.first;
+        }
+    }
+    if (worstBandwidth > 0.0) {
+        result.addValue("Bank conflict penalty", QString("stride %1").arg(worstStride), unitStrideBandwidth / worstBandwidth, "x");
+    }
+    cl_uint bankCount = 0;
+    bool plateau = false;
+    double previousBandwidth = unitStrideBandwidth;
+    cl_uint largestStride = 1;
+    for (auto& bandwidth : bandwidths) {
+        const cl_uint stride = bandwidth.first;
+        if ((stride == 1) || (stride & (stride - 1)) || (bandwidth.second <= 0.0)) {
+            continue;
+        }
+        largestStride = stride;
+        if (previousBandwidth / bandwidth.second < 1.3) {
+            // No further slowdown, the previous stride was the bank count (if there was a slowdown at all)
+            plateau = true;
+            if (unitStrideBandwidth / bandwidth.second > 1.5) {
+                bankCount = stride / 2;
+            }
+            break;
+        }
+        previousBandwidth = bandwidth.second;
+    }
+    if (!plateau && (largestStride > 1)) {
+        // Still slowing down at the largest stride tested
+        result.addValue("Estimated bank count", "at least", double(largestStride), "");
+    } else if (bankCount > 0) {
+        result.addValue("Estimated bank count", double(bankCount), "");
+    } else {
+        result.addValue("Estimated bank count", "no bank conflicts detected", 0.0, "");
+    }
+
+    // Barrier cost as the difference to the same loop without barriers, two barriers per iteration
+    const cl_int barrierIterations = 4096;
+    size_t barrierLocalSize = std::min(localSize, size_t(1024));
+    size_t barrierKernelLimit = barrierLocalSize;
+    _clGetKernelWorkGroupInfo(barrierKernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &barrierKernelLimit, nullptr);
+    barrierLocalSize = std::min(barrierLocalSize, barrierKernelLimit);
+    const size_t barrierGlobalSize = barrierLocalSize * computeUnits;
+    BenchmarkTimings barrierTimings;
+    BenchmarkTimings noBarrierTimings;
+    for (cl_kernel kernel : { barrierKernel, noBarrierKernel }) {
+        _clSetKernelArg(kernel, 0, sizeof(cl_mem), &outputBuffer);
+        _clSetKernelArg(kernel, 1, sizeof(cl_int), &barrierIterations);
+        if (!context.timeKernel(kernel, 1, &barrierGlobalSize, &barrierLocalSize, (kernel == barrierKernel) ? barrierTimings : noBarrierTimings, error)) {
+            return false;
+        }
+    }
+    const double barrierCost = std::max(barrierTimings.median() - noBarrierTimings.median(), 0.0) / (2.0 * barrierIterations);
+    result.addValue("Barrier cost", QString("work group size %1").arg(barrierLocalSize), barrierCost, "ns");
+
+    // Local versus global memory latency, global is measured for the same size (usually cached) and a large buffer
+    std::vector<cl_uint> chain = randomCycle(chaseSize);
+    cl_mem chainBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, chain.size() * sizeof(cl_uint), chain.data(), error);
+    if (!chainBuffer) {
+        return false;
+    }
+    size_t chaseLocalSize = 1;
+    _clGetKernelWorkGroupInfo(chaseLocalKernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &chaseLocalSize, nullptr);
+    chaseLocalSize = std::min(chaseLocalSize, size_t(64));
+    double latency = 0.0;
+    if (!chaseLatency(context, chaseLocalKernel, chainBuffer, outputBuffer, chaseLocalSize, latency, error)) {
+        return false;
+    }
+    result.addValue("Local memory latency", sizeString(chaseSize * sizeof(cl_uint)), latency, "ns");
+    if (!chaseLatency(context, chaseGlobalKernel, chainBuffer, outputBuffer, 1, latency, error)) {
+        return false;
+    }
+    result.addValue("Global memory latency", sizeString(chaseSize * sizeof(cl_uint)), latency, "ns");
+
+    size_t largeChaseSize = size_t(32) * 1024 * 1024;
+    while ((largeChaseSize > context.maxBufferSize()) && (largeChaseSize > 1024 * 1024)) {
+        largeChaseSize /= 2;
+    }
+    std::vector<cl_uint> largeChain = randomCycle(cl_uint(largeChaseSize / sizeof(cl_uint)));
+    cl_mem largeChainBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, largeChaseSize, largeChain.data(), error);
+    if (!largeChainBuffer) {
+        return false;
+    }
+    if (!chaseLatency(context, chaseGlobalKernel, largeChainBuffer, outputBuffer, 1, latency, error)) {
+        return false;
+    }
+    result.addValue("Global memory latency", sizeString(largeChaseSize), latency, "ns");
+    return true;
+}
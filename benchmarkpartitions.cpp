@@ -0,0 +1,437 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <limits>
+
+// Compute bound workload with four independent fma chains per work-item, and a memory bound copy
+static const char* partitionSource = R"(
+__kernel void compute(__global float* data, int iterations)
+{
+    const size_t gid = get_global_id(0);
+    float a = data[gid];
+    float b = a + 1.0f;
+    float c = a + 2.0f;
+    float d = a + 3.0f;
+    for (int i = 0; i < iterations; i++) {
+        a = fma(a, 0.9999f, 0.0001f);
+        b = fma(b, 0.9999f, 0.0001f);
+        c = fma(c, 0.9999f, 0.0001f);
+        d = fma(d, 0.9999f, 0.0001f);
+    }
+    data[gid] = a + b + c + d;
+}
+
+__kernel void copy(__global const float4* source, __global float4* destination)
+{
+    destination[get_global_id(0)] = source[get_global_id(0)];
+}
+)";
+
+// Workloads are indices into the per device kernel, size and work arrays
+static const int computeWorkload = 0;
+static const int memoryWorkload = 1;
+static const int workloadCount = 2;
+static const char* workloadNames[workloadCount] = { "Compute throughput", "Memory throughput" };
+static const char* workloadUnits[workloadCount] = { "GFLOPS", "GB/s" };
+
+static const int computeIterations = 4096;
+// The compute work of each (sub-)device scales with its number of compute units
+static const size_t computeItemsPerUnit = 2048;
+// Levels of sub-devices probed for the partition tree
+static const int maxPartitionDepth = 4;
+
+template<typename T>
+static T subDeviceValue(cl_device_id device, cl_device_info info)
+{
+    T value{};
+    _clGetDeviceInfo(device, info, sizeof(T), &value, nullptr);
+    return value;
+}
+
+static std::vector<cl_device_partition_property> partitionProperties(cl_device_id device)
+{
+    size_t valueSize = 0;
+    _clGetDeviceInfo(device, CL_DEVICE_PARTITION_PROPERTIES, 0, nullptr, &valueSize);
+    std::vector<cl_device_partition_property> values(valueSize / sizeof(cl_device_partition_property));
+    if (!values.empty()) {
+        _clGetDeviceInfo(device, CL_DEVICE_PARTITION_PROPERTIES, valueSize, values.data(), nullptr);
+    }
+    // Devices that can't be partitioned may return a single zero instead of an empty list
+    values.erase(std::remove(values.begin(), values.end(), 0), values.end());
+    return values;
+}
+
+// All schemes are tried for the device itself, nested partitions only follow the next partitionable affinity domain (or halves)
+// so the tree mirrors the hardware hierarchy instead of growing with every combination
+static std::vector<std::vector<cl_device_partition_property>> partitionSchemes(cl_device_id device, bool nested)
+{
+    std::vector<std::vector<cl_device_partition_property>> schemes;
+    const cl_uint computeUnits = subDeviceValue<cl_uint>(device, CL_DEVICE_MAX_COMPUTE_UNITS);
+    const cl_uint maxSubDevices = subDeviceValue<cl_uint>(device, CL_DEVICE_PARTITION_MAX_SUB_DEVICES);
+    const cl_device_affinity_domain affinityDomains = subDeviceValue<cl_device_affinity_domain>(device, CL_DEVICE_PARTITION_AFFINITY_DOMAIN);
+    if ((computeUnits < 2) || (maxSubDevices < 2)) {
+        return schemes;
+    }
+    const std::vector<cl_device_partition_property> properties = partitionProperties(device);
+    const bool equally = std::find(properties.begin(), properties.end(), CL_DEVICE_PARTITION_EQUALLY) != properties.end();
+    const bool byCounts = std::find(properties.begin(), properties.end(), CL_DEVICE_PARTITION_BY_COUNTS) != properties.end();
+    const bool byAffinityDomain = std::find(properties.begin(), properties.end(), CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN) != properties.end();
+    if (nested) {
+        if (byAffinityDomain && (affinityDomains & CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE)) {
+            schemes.push_back({ CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN, CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE, 0 });
+        } else if (equally) {
+            schemes.push_back({ CL_DEVICE_PARTITION_EQUALLY, cl_device_partition_property(computeUnits / 2), 0 });
+        }
+        return schemes;
+    }
+    if (equally) {
+        for (cl_uint parts : { 2u, 4u }) {
+            const cl_uint units = computeUnits / parts;
+            if ((units > 0) && (computeUnits / units <= maxSubDevices)) {
+                schemes.push_back({ CL_DEVICE_PARTITION_EQUALLY, cl_device_partition_property(units), 0 });
+            }
+        }
+    }
+    if (byCounts) {
+        // Uneven split, to see if throughput follows the number of compute units
+        const cl_uint smaller = std::max(computeUnits / 4, 1u);
+        schemes.push_back({ CL_DEVICE_PARTITION_BY_COUNTS, cl_device_partition_property(computeUnits - smaller), cl_device_partition_property(smaller), CL_DEVICE_PARTITION_BY_COUNTS_LIST_END, 0 });
+    }
+    if (byAffinityDomain) {
+        for (cl_device_affinity_domain domain : { CL_DEVICE_AFFINITY_DOMAIN_NUMA, CL_DEVICE_AFFINITY_DOMAIN_L4_CACHE, CL_DEVICE_AFFINITY_DOMAIN_L3_CACHE, CL_DEVICE_AFFINITY_DOMAIN_L2_CACHE, CL_DEVICE_AFFINITY_DOMAIN_L1_CACHE, CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE }) {
+            if (affinityDomains & domain) {
+                schemes.push_back({ CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN, cl_device_partition_property(domain), 0 });
+            }
+        }
+    }
+    return schemes;
+}
+
+static QString affinityDomainName(cl_device_partition_property domain)
+{
+    switch (domain)
+    {
+    case CL_DEVICE_AFFINITY_DOMAIN_NUMA: return "NUMA";
+    case CL_DEVICE_AFFINITY_DOMAIN_L4_CACHE: return "L4 cache";
+    case CL_DEVICE_AFFINITY_DOMAIN_L3_CACHE: return "L3 cache";
+    case CL_DEVICE_AFFINITY_DOMAIN_L2_CACHE: return "L2 cache";
+    case CL_DEVICE_AFFINITY_DOMAIN_L1_CACHE: return "L1 cache";
+    case CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE: return "next partitionable";
+    default: return "unknown";
+    }
+}
+
+static QString schemeName(const std::vector<cl_device_partition_property>& scheme)
+{
+    switch (scheme[0])
+    {
+    case CL_DEVICE_PARTITION_EQUALLY:
+        return QString("equally, %1 compute units").arg(scheme[1]);
+    case CL_DEVICE_PARTITION_BY_COUNTS:
+    {
+        QStringList counts;
+        for (size_t i = 1; (i < scheme.size()) && (scheme[i] != CL_DEVICE_PARTITION_BY_COUNTS_LIST_END); i++) {
+            counts.append(QString::number(scheme[i]));
+        }
+        return "by counts " + counts.join("+");
+    }
+    case CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN:
+        return "by affinity domain " + affinityDomainName(scheme[1]);
+    default:
+        return "unknown";
+    }
+}
+
+// Releases the created sub-devices when going out of scope
+struct SubDevices
+{
+    std::vector<cl_device_id> ids;
+    ~SubDevices()
+    {
+        for (auto id : ids) {
+            _clReleaseDevice(id);
+        }
+    }
+    bool create(cl_device_id device, const std::vector<cl_device_partition_property>& scheme, QString& error)
+    {
+        cl_uint count = 0;
+        cl_int status = _clCreateSubDevices(device, scheme.data(), 0, nullptr, &count);
+        if ((status == CL_SUCCESS) && (count > 0)) {
+            ids.resize(count);
+            status = _clCreateSubDevices(device, scheme.data(), count, ids.data(), nullptr);
+        }
+        if ((status != CL_SUCCESS) || ids.empty()) {
+            ids.clear();
+            error = (status != CL_SUCCESS) ? utils::errorString(status) : "No sub-devices created";
+            return false;
+        }
+        return true;
+    }
+};
+
+static std::vector<DevicePartition> probePartitions(cl_device_id device, int depth);
+
+static SubDeviceInfo probeSubDevice(cl_device_id device, int depth)
+{
+    SubDeviceInfo info;
+    info.computeUnits = subDeviceValue<cl_uint>(device, CL_DEVICE_MAX_COMPUTE_UNITS);
+    info.globalMemSize = subDeviceValue<cl_ulong>(device, CL_DEVICE_GLOBAL_MEM_SIZE);
+    info.globalMemCacheSize = subDeviceValue<cl_ulong>(device, CL_DEVICE_GLOBAL_MEM_CACHE_SIZE);
+    info.maxWorkGroupSize = subDeviceValue<size_t>(device, CL_DEVICE_MAX_WORK_GROUP_SIZE);
+    info.partitionMaxSubDevices = subDeviceValue<cl_uint>(device, CL_DEVICE_PARTITION_MAX_SUB_DEVICES);
+    info.partitionProperties = partitionProperties(device);
+    info.partitionAffinityDomain = subDeviceValue<cl_device_affinity_domain>(device, CL_DEVICE_PARTITION_AFFINITY_DOMAIN);
+    if (depth < maxPartitionDepth) {
+        info.partitions = probePartitions(device, depth + 1);
+    }
+    return info;
+}
+
+// Sub-devices are only kept alive while their own partitions are probed
+static std::vector<DevicePartition> probePartitions(cl_device_id device, int depth)
+{
+    std::vector<DevicePartition> partitions;
+    for (auto& scheme : partitionSchemes(device, depth > 1)) {
+        DevicePartition partition;
+        partition.scheme = schemeName(scheme);
+        partition.properties = scheme;
+        SubDevices subDevices;
+        if (subDevices.create(device, scheme, partition.error)) {
+            for (auto id : subDevices.ids) {
+                partition.subDevices.push_back(probeSubDevice(id, depth));
+            }
+        } else {
+            qWarning() << "Could not partition device" << partition.scheme << partition.error;
+        }
+        partitions.push_back(partition);
+    }
+    return partitions;
+}
+
+// Kernels of the workloads on a (sub-)device, created in the benchmark context of that device
+struct PartitionWorkloads
+{
+    cl_kernel kernels[workloadCount] = {};
+    size_t globalSizes[workloadCount] = {};
+    // Floating point operations or bytes per run
+    double work[workloadCount] = {};
+};
+
+static bool createWorkloads(BenchmarkContext& context, size_t copySize, PartitionWorkloads& workloads, QString& error)
+{
+    cl_program program = context.buildProgram(partitionSource, "", error);
+    if (!program) {
+        return false;
+    }
+    const char* kernelNames[workloadCount] = { "compute", "copy" };
+    for (int workload = 0; workload < workloadCount; workload++) {
+        workloads.kernels[workload] = context.createKernel(program, kernelNames[workload], error);
+        if (!workloads.kernels[workload]) {
+            return false;
+        }
+    }
+    const cl_uint computeUnits = context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS);
+    workloads.globalSizes[computeWorkload] = std::max(computeUnits, 1u) * computeItemsPerUnit;
+    workloads.work[computeWorkload] = double(workloads.globalSizes[computeWorkload]) * computeIterations * 4 * 2;
+    workloads.globalSizes[memoryWorkload] = copySize / sizeof(cl_float4);
+    workloads.work[memoryWorkload] = double(copySize) * 2;
+    // Initialized to avoid running into denormal or NaN slow paths
+    std::vector<cl_float> computeData(workloads.globalSizes[computeWorkload], 1.0f);
+    cl_mem computeBuffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, computeData.size() * sizeof(cl_float), computeData.data(), error);
+    cl_mem sourceBuffer = computeBuffer ? context.createBuffer(CL_MEM_READ_ONLY, copySize, nullptr, error) : nullptr;
+    cl_mem destinationBuffer = sourceBuffer ? context.createBuffer(CL_MEM_WRITE_ONLY, copySize, nullptr, error) : nullptr;
+    if (!destinationBuffer) {
+        return false;
+    }
+    _clSetKernelArg(workloads.kernels[computeWorkload], 0, sizeof(cl_mem), &computeBuffer);
+    _clSetKernelArg(workloads.kernels[computeWorkload], 1, sizeof(cl_int), &computeIterations);
+    _clSetKernelArg(workloads.kernels[memoryWorkload], 0, sizeof(cl_mem), &sourceBuffer);
+    _clSetKernelArg(workloads.kernels[memoryWorkload], 1, sizeof(cl_mem), &destinationBuffer);
+    return true;
+}
+
+// Runs the workload on all sub-devices at the same time, the device times are taken from the profiling events
+// The total time is the span from the earliest start to the latest end, so it's measured with the same clock as the root device
+// Sub-devices share the device timer of their root device, so the timestamps of different sub-devices can be compared
+static bool timeConcurrently(const std::vector<std::unique_ptr<BenchmarkContext>>& contexts, const std::vector<PartitionWorkloads>& workloads, int workload, const BenchmarkSettings& settings, std::vector<double>& deviceTimes, double& totalTime, QString& error)
+{
+    std::vector<BenchmarkTimings> deviceTimings(contexts.size());
+    BenchmarkTimings totalTimings;
+    std::vector<cl_event> events(contexts.size(), nullptr);
+    for (uint32_t run = 0; run < settings.warmupIterations + settings.iterations; run++) {
+        cl_int status = CL_SUCCESS;
+        for (size_t i = 0; (i < contexts.size()) && (status == CL_SUCCESS); i++) {
+            status = _clEnqueueNDRangeKernel(contexts[i]->queue, workloads[i].kernels[workload], 1, nullptr, &workloads[i].globalSizes[workload], nullptr, 0, nullptr, &events[i]);
+        }
+        for (auto& context : contexts) {
+            _clFlush(context->queue);
+        }
+        for (auto& context : contexts) {
+            _clFinish(context->queue);
+        }
+        if ((status == CL_SUCCESS) && (run >= settings.warmupIterations)) {
+            cl_ulong firstStart = std::numeric_limits<cl_ulong>::max();
+            cl_ulong lastEnd = 0;
+            for (size_t i = 0; i < contexts.size(); i++) {
+                deviceTimings[i].samples.push_back(BenchmarkContext::eventDuration(events[i]));
+                cl_ulong start = 0;
+                cl_ulong end = 0;
+                _clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr);
+                _clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr);
+                firstStart = std::min(firstStart, start);
+                lastEnd = std::max(lastEnd, end);
+            }
+            totalTimings.samples.push_back((lastEnd > firstStart) ? double(lastEnd - firstStart) : 0.0);
+        }
+        for (auto& event : events) {
+            if (event) {
+                _clReleaseEvent(event);
+                event = nullptr;
+            }
+        }
+        if (status != CL_SUCCESS) {
+            error = "Could not enqueue kernel: " + utils::errorString(status);
+            return false;
+        }
+    }
+    deviceTimes.resize(contexts.size());
+    for (size_t i = 0; i < contexts.size(); i++) {
+        deviceTimes[i] = deviceTimings[i].median();
+    }
+    totalTime = totalTimings.median();
+    return true;
+}
+
+// Size of each copy buffer, so the buffers of all partitions fit into the allocation limit
+static size_t copySize(BenchmarkContext& context, size_t deviceCount)
+{
+    size_t size = size_t(64) * 1024 * 1024;
+    while ((size * 2 * deviceCount > context.maxBufferSize()) && (size > 1024 * 1024)) {
+        size /= 2;
+    }
+    return size;
+}
+
+bool PartitionBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if ((context.device.clVersionMajor == 1) && (context.device.clVersionMinor < 2)) {
+        reason = "Sub-devices require OpenCL 1.2";
+        return false;
+    }
+    if (!_clCreateSubDevices || !_clReleaseDevice) {
+        reason = "clCreateSubDevices is not available";
+        return false;
+    }
+    if (partitionSchemes(context.device.deviceId, false).empty()) {
+        reason = "Device can't be partitioned";
+        return false;
+    }
+    return true;
+}
+
+bool PartitionBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const cl_device_id rootDevice = context.device.deviceId;
+    context.results.partitions = probePartitions(rootDevice, 1);
+
+    // Throughput of the whole device as the baseline for the partitions
+    double rootThroughput[workloadCount] = {};
+    PartitionWorkloads rootWorkloads;
+    if (!createWorkloads(context, copySize(context, 1), rootWorkloads, error)) {
+        return false;
+    }
+    for (int workload = 0; workload < workloadCount; workload++) {
+        BenchmarkTimings timings;
+        if (!context.timeKernel(rootWorkloads.kernels[workload], 1, &rootWorkloads.globalSizes[workload], nullptr, timings, error)) {
+            return false;
+        }
+        rootThroughput[workload] = (timings.median() > 0.0) ? rootWorkloads.work[workload] / timings.median() : 0.0;
+        result.addValue(workloadNames[workload], "root device", rootThroughput[workload], workloadUnits[workload]);
+    }
+    // Frees the memory of the root device buffers for the partitions
+    context.releaseObjects();
+
+    // Each partition alone and all partitions of a scheme at the same time, the difference shows how much they interfere
+    // Every sub-device gets a benchmark context of its own, all objects are released when they go out of scope
+    QStringList failedSchemes;
+    for (auto& scheme : partitionSchemes(rootDevice, false)) {
+        const QString name = schemeName(scheme);
+        QString partitionError;
+        SubDevices subDevices;
+        if (!subDevices.create(rootDevice, scheme, partitionError)) {
+            qWarning() << "Skipping partition scheme" << name << partitionError;
+            failedSchemes.append(name + " (" + partitionError + ")");
+            continue;
+        }
+        std::vector<std::unique_ptr<BenchmarkContext>> subDeviceContexts;
+        std::vector<PartitionWorkloads> workloads(subDevices.ids.size());
+        for (size_t i = 0; i < subDevices.ids.size(); i++) {
+            subDeviceContexts.emplace_back(new BenchmarkContext(context.device, context.settings, subDevices.ids[i]));
+            if (!subDeviceContexts.back()->create(partitionError) || !createWorkloads(*subDeviceContexts.back(), copySize(context, subDevices.ids.size()), workloads[i], partitionError)) {
+                break;
+            }
+        }
+        if (!partitionError.isEmpty()) {
+            qWarning() << "Skipping partition scheme" << name << partitionError;
+            failedSchemes.append(name + " (" + partitionError + ")");
+            continue;
+        }
+        for (int workload = 0; workload < workloadCount; workload++) {
+            std::vector<double> isolatedTimes(subDeviceContexts.size());
+            for (size_t i = 0; i < subDeviceContexts.size(); i++) {
+                BenchmarkTimings timings;
+                if (!subDeviceContexts[i]->timeKernel(workloads[i].kernels[workload], 1, &workloads[i].globalSizes[workload], nullptr, timings, error)) {
+                    return false;
+                }
+                isolatedTimes[i] = timings.median();
+            }
+            std::vector<double> concurrentTimes;
+            double totalTime = 0.0;
+            if (!timeConcurrently(subDeviceContexts, workloads, workload, context.settings, concurrentTimes, totalTime, error)) {
+                return false;
+            }
+            double totalWork = 0.0;
+            for (size_t i = 0; i < subDeviceContexts.size(); i++) {
+                const QString detail = QString("%1, sub-device %2 (%3 compute units)").arg(name).arg(i).arg(subDeviceContexts[i]->deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS));
+                totalWork += workloads[i].work[workload];
+                if ((isolatedTimes[i] <= 0.0) || (concurrentTimes[i] <= 0.0)) {
+                    continue;
+                }
+                const double isolated = workloads[i].work[workload] / isolatedTimes[i];
+                const double concurrent = workloads[i].work[workload] / concurrentTimes[i];
+                result.addValue(workloadNames[workload], detail + ", alone", isolated, workloadUnits[workload]);
+                result.addValue(workloadNames[workload], detail + ", concurrent", concurrent, workloadUnits[workload]);
+                result.addValue(QString(workloadNames[workload]) + " under interference", detail, 100.0 * concurrent / isolated, "%");
+            }
+            if (totalTime > 0.0) {
+                const double aggregate = totalWork / totalTime;
+                result.addValue(workloadNames[workload], name + ", all sub-devices concurrently", aggregate, workloadUnits[workload]);
+                if (rootThroughput[workload] > 0.0) {
+                    result.addValue(QString(workloadNames[workload]) + " scaling", name + ", relative to root device", aggregate / rootThroughput[workload], "x");
+                }
+            }
+        }
+    }
+    if (!failedSchemes.isEmpty()) {
+        result.message = "Could not run partition schemes: " + failedSchemes.join(", ");
+    }
+    return true;
+}
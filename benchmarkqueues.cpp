@@ -0,0 +1,333 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <limits>
+
+// Dependent mad chains that keep a fraction of the device busy for the calibrated number of iterations
+static const char* queuesSource = R"(
+__kernel void busy(__global float* output, const float seed, const int iterations)
+{
+    float a = seed + (float)get_global_id(0);
+    float b = seed - (float)get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        a = mad(a, seed, 0.5f);
+        b = mad(b, seed, 0.25f);
+    }
+    output[get_global_id(0)] = a + b;
+}
+)";
+
+static const cl_uint maxQueues = 8;
+static const cl_uint commandsPerQueue = 4;
+static const size_t transferSize = 16 * 1024 * 1024;
+
+// Reconstructed from the profiling events of all commands of a run
+struct Timeline
+{
+    // From the start of the first command to the end of the last one
+    double span = 0.0;
+    // Sum of all command durations
+    double busy = 0.0;
+    // Highest number of commands executing at the same time
+    cl_uint maxOverlap = 0;
+};
+
+// Enqueues the commands round robin to all queues, so every queue has work pending while the others run
+static bool runTimeline(const std::vector<cl_command_queue>& queues, const std::function<cl_int(size_t, cl_event*)>& enqueue, Timeline& timeline, QString& error)
+{
+    std::vector<cl_event> events;
+    cl_int status = CL_SUCCESS;
+    for (cl_uint i = 0; (i < commandsPerQueue) && (status == CL_SUCCESS); i++) {
+        for (size_t queueIndex = 0; (queueIndex < queues.size()) && (status == CL_SUCCESS); queueIndex++) {
+            cl_event event = nullptr;
+            status = enqueue(queueIndex, &event);
+            if (status == CL_SUCCESS) {
+                events.push_back(event);
+            }
+        }
+    }
+    for (auto queue : queues) {
+        _clFlush(queue);
+    }
+    if ((status == CL_SUCCESS) && !events.empty()) {
+        status = _clWaitForEvents(cl_uint(events.size()), events.data());
+    }
+
+    // Profiling timestamps of all queues of a device are taken from the same device timer, so they can be merged into one timeline
+    std::vector<std::pair<cl_ulong, int>> edges;
+    cl_ulong first = std::numeric_limits<cl_ulong>::max();
+    cl_ulong last = 0;
+    timeline = Timeline();
+    for (auto event : events) {
+        cl_ulong start = 0;
+        cl_ulong end = 0;
+        _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr);
+        _clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr);
+        _clReleaseEvent(event);
+        if (end > start) {
+            first = std::min(first, start);
+            last = std::max(last, end);
+            timeline.busy += double(end - start);
+            edges.push_back({ start, 1 });
+            edges.push_back({ end, -1 });
+        }
+    }
+    if (status != CL_SUCCESS) {
+        error = "Could not run commands: " + utils::errorString(status);
+        return false;
+    }
+    // Ends sort before starts with the same timestamp, so back to back commands don't count as overlapping
+    std::sort(edges.begin(), edges.end());
+    int running = 0;
+    for (auto& edge : edges) {
+        running += edge.second;
+        timeline.maxOverlap = std::max(timeline.maxOverlap, cl_uint(std::max(running, 0)));
+    }
+    timeline.span = (last > first) ? double(last - first) : 0.0;
+    return true;
+}
+
+// Runs the timeline for all warmup and measured iterations and returns the run with the median span
+static bool measureTimeline(BenchmarkContext& context, const std::vector<cl_command_queue>& queues, const std::function<cl_int(size_t, cl_event*)>& enqueue, Timeline& timeline, QString& error)
+{
+    std::vector<Timeline> runs;
+    for (uint32_t i = 0; i < context.settings.warmupIterations + context.settings.iterations; i++) {
+        Timeline run;
+        if (!runTimeline(queues, enqueue, run, error)) {
+            return false;
+        }
+        if (i >= context.settings.warmupIterations) {
+            runs.push_back(run);
+        }
+    }
+    std::sort(runs.begin(), runs.end(), [](const Timeline& a, const Timeline& b) { return a.span < b.span; });
+    timeline = runs[runs.size() / 2];
+    return true;
+}
+
+struct QueueWorkload
+{
+    cl_kernel kernel = nullptr;
+    size_t globalSize = 0;
+    size_t localSize = 0;
+    // One output buffer for kernels and one destination buffer for transfers per queue, so commands of different queues never share memory objects
+    std::vector<cl_mem> outputs;
+    std::vector<cl_mem> destinations;
+    std::vector<char> source;
+    cl_int enqueueKernel(cl_command_queue queue, size_t queueIndex, cl_event* event)
+    {
+        _clSetKernelArg(kernel, 0, sizeof(cl_mem), &outputs[queueIndex]);
+        return _clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &globalSize, &localSize, 0, nullptr, event);
+    }
+    cl_int enqueueTransfer(cl_command_queue queue, size_t queueIndex, cl_event* event)
+    {
+        return _clEnqueueWriteBuffer(queue, destinations[queueIndex], CL_FALSE, 0, source.size(), source.data(), 0, nullptr, event);
+    }
+};
+
+// Aggregate kernel and transfer throughput for one to the given number of queues, relative to a single queue
+static bool measureScaling(BenchmarkContext& context, QueueWorkload& workload, const std::vector<cl_command_queue>& allQueues, bool kernels, bool transfers, const QString& prefix, BenchmarkResult& result, QString& error)
+{
+    // Powers of two plus the total number of queues
+    std::vector<cl_uint> counts;
+    for (cl_uint count = 1; count < allQueues.size(); count *= 2) {
+        counts.push_back(count);
+    }
+    counts.push_back(cl_uint(allQueues.size()));
+    double kernelSpan = 0.0;
+    for (cl_uint count : counts) {
+        const std::vector<cl_command_queue> queues(allQueues.begin(), allQueues.begin() + count);
+        const QString detail = prefix + QString("%1 %2").arg(count).arg((count == 1) ? "queue" : "queues");
+        Timeline timeline;
+        if (kernels) {
+            if (!measureTimeline(context, queues, [&](size_t queueIndex, cl_event* event) { return workload.enqueueKernel(queues[queueIndex], queueIndex, event); }, timeline, error)) {
+                return false;
+            }
+            if (count == 1) {
+                kernelSpan = timeline.span;
+            } else if (timeline.span > 0.0) {
+                result.addValue("Kernel throughput", detail + ", relative to one queue", count * kernelSpan / timeline.span, "x");
+            }
+            if (timeline.span > 0.0) {
+                result.addValue("Kernel concurrency", detail + ", average", timeline.busy / timeline.span, "kernels");
+            }
+            result.addValue("Kernel concurrency", detail + ", maximum", timeline.maxOverlap, "kernels");
+        }
+        if (transfers) {
+            if (!measureTimeline(context, queues, [&](size_t queueIndex, cl_event* event) { return workload.enqueueTransfer(queues[queueIndex], queueIndex, event); }, timeline, error)) {
+                return false;
+            }
+            const double bytes = double(workload.source.size()) * count * commandsPerQueue;
+            result.addValue("Transfer throughput", detail, (timeline.span > 0.0) ? bytes / timeline.span : 0.0, "GB/s");
+            if (timeline.span > 0.0) {
+                result.addValue("Transfer concurrency", detail + ", average", timeline.busy / timeline.span, "transfers");
+            }
+        }
+    }
+    return true;
+}
+
+// Share of the shorter workload that was hidden by running kernels and transfers on separate queues at the same time
+static bool measureOverlap(BenchmarkContext& context, QueueWorkload& workload, cl_command_queue computeQueue, cl_command_queue copyQueue, const QString& detail, BenchmarkResult& result, double& overlap, QString& error)
+{
+    Timeline computeTimeline;
+    Timeline copyTimeline;
+    Timeline combinedTimeline;
+    const std::vector<cl_command_queue> queues = { computeQueue, copyQueue };
+    auto enqueueCompute = [&](size_t, cl_event* event) { return workload.enqueueKernel(computeQueue, 0, event); };
+    auto enqueueCopy = [&](size_t, cl_event* event) { return workload.enqueueTransfer(copyQueue, 1, event); };
+    auto enqueueCombined = [&](size_t queueIndex, cl_event* event) { return (queueIndex == 0) ? enqueueCompute(0, event) : enqueueCopy(1, event); };
+    if (!measureTimeline(context, { computeQueue }, enqueueCompute, computeTimeline, error) ||
+        !measureTimeline(context, { copyQueue }, enqueueCopy, copyTimeline, error) ||
+        !measureTimeline(context, queues, enqueueCombined, combinedTimeline, error)) {
+        return false;
+    }
+    const double shorter = std::min(computeTimeline.span, copyTimeline.span);
+    const double hidden = computeTimeline.span + copyTimeline.span - combinedTimeline.span;
+    overlap = (shorter > 0.0) ? std::max(0.0, std::min(1.0, hidden / shorter)) : 0.0;
+    result.addValue("Copy compute overlap", detail, overlap * 100.0, "%");
+    result.addValue("Copy compute overlap", detail + ", kernels only", computeTimeline.span / 1e6, "ms");
+    result.addValue("Copy compute overlap", detail + ", transfers only", copyTimeline.span / 1e6, "ms");
+    result.addValue("Copy compute overlap", detail + ", both", combinedTimeline.span / 1e6, "ms");
+    return true;
+}
+
+bool QueuesBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    QueueWorkload workload;
+    cl_program program = context.buildProgram(queuesSource, "", error);
+    if (!program) {
+        return false;
+    }
+    workload.kernel = context.createKernel(program, "busy", error);
+    if (!workload.kernel) {
+        return false;
+    }
+    // Kernels only occupy a part of the compute units, otherwise there would be nothing left for kernels from other queues
+    const cl_uint computeUnits = std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+    size_t maxWorkGroupSize = 1;
+    _clGetKernelWorkGroupInfo(workload.kernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxWorkGroupSize, nullptr);
+    workload.localSize = std::max(std::min(maxWorkGroupSize, size_t(64)), size_t(1));
+    workload.globalSize = workload.localSize * std::max(computeUnits / 4, 1u);
+    workload.source.resize(transferSize, 1);
+    for (cl_uint i = 0; i < maxQueues; i++) {
+        cl_mem output = context.createBuffer(CL_MEM_WRITE_ONLY, workload.globalSize * sizeof(cl_float), nullptr, error);
+        cl_mem destination = context.createBuffer(CL_MEM_READ_WRITE, transferSize, nullptr, error);
+        if (!output || !destination) {
+            return false;
+        }
+        workload.outputs.push_back(output);
+        workload.destinations.push_back(destination);
+    }
+
+    // Kernel runs of about 2 ms, long enough for commands of other queues to start while one is running
+    const cl_float seed = 0.999f;
+    cl_int iterations = 1024;
+    _clSetKernelArg(workload.kernel, 0, sizeof(cl_mem), &workload.outputs[0]);
+    _clSetKernelArg(workload.kernel, 1, sizeof(cl_float), &seed);
+    const BenchmarkSettings settings = context.settings;
+    context.settings.warmupIterations = 1;
+    context.settings.iterations = 1;
+    while (true) {
+        _clSetKernelArg(workload.kernel, 2, sizeof(cl_int), &iterations);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(workload.kernel, 1, &workload.globalSize, &workload.localSize, timings, error)) {
+            context.settings = settings;
+            return false;
+        }
+        if ((timings.median() >= 2e6) || (iterations >= (1 << 24))) {
+            break;
+        }
+        iterations *= 2;
+    }
+    context.settings = settings;
+
+    // Regular queues of the default queue family
+    std::vector<cl_command_queue> queues;
+    for (cl_uint i = 0; i < maxQueues; i++) {
+        cl_command_queue queue = context.createQueue(CL_QUEUE_PROFILING_ENABLE, error);
+        if (!queue) {
+            return false;
+        }
+        queues.push_back(queue);
+    }
+    if (!measureScaling(context, workload, queues, true, true, "", result, error)) {
+        return false;
+    }
+    double overlap = 0.0;
+    if (!measureOverlap(context, workload, queues[0], queues[1], "separate queues", result, overlap, error)) {
+        return false;
+    }
+    QStringList notes;
+    if (context.device.extensionSupported("cl_nv_device_attribute_query") && (context.deviceValue<cl_bool>(CL_DEVICE_GPU_OVERLAP_NV) == CL_TRUE) && (overlap < 0.1)) {
+        notes.append("CL_DEVICE_GPU_OVERLAP_NV is reported, but kernels and transfers on separate queues did not overlap");
+    }
+
+    // Intel queue families, e.g. compute engines and dedicated copy engines, each with its own number of queues
+    if (context.device.extensionSupported("cl_intel_command_queue_families")) {
+        size_t valueSize = 0;
+        _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_QUEUE_FAMILY_PROPERTIES_INTEL, 0, nullptr, &valueSize);
+        std::vector<cl_queue_family_properties_intel> families(valueSize / sizeof(cl_queue_family_properties_intel));
+        _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_QUEUE_FAMILY_PROPERTIES_INTEL, valueSize, families.data(), nullptr);
+        cl_command_queue computeQueue = nullptr;
+        cl_command_queue copyQueue = nullptr;
+        QString copyFamilyName;
+        for (cl_uint family = 0; family < families.size(); family++) {
+            const cl_queue_family_properties_intel& properties = families[family];
+            if (!(properties.properties & CL_QUEUE_PROFILING_ENABLE) || (properties.count == 0)) {
+                continue;
+            }
+            const bool allCapabilities = (properties.capabilities == CL_QUEUE_DEFAULT_CAPABILITIES_INTEL);
+            const bool kernels = allCapabilities || (properties.capabilities & CL_QUEUE_CAPABILITY_KERNEL_INTEL);
+            const bool transfers = allCapabilities || (properties.capabilities & CL_QUEUE_CAPABILITY_TRANSFER_BUFFER_INTEL);
+            if (!kernels && !transfers) {
+                continue;
+            }
+            const QString familyName = QString::fromLatin1(properties.name).trimmed();
+            std::vector<cl_command_queue> familyQueues;
+            for (cl_uint index = 0; index < std::min(properties.count, maxQueues); index++) {
+                cl_command_queue queue = context.createFamilyQueue(family, index, CL_QUEUE_PROFILING_ENABLE, error);
+                if (!queue) {
+                    return false;
+                }
+                familyQueues.push_back(queue);
+            }
+            if (!measureScaling(context, workload, familyQueues, kernels, transfers, QString("family %1 (%2), ").arg(family).arg(familyName), result, error)) {
+                return false;
+            }
+            if (kernels && !computeQueue) {
+                computeQueue = familyQueues[0];
+            }
+            // Dedicated copy engines are the families that can transfer but not run kernels
+            if (transfers && !kernels && !copyQueue) {
+                copyQueue = familyQueues[0];
+                copyFamilyName = familyName;
+            }
+        }
+        if (computeQueue && copyQueue) {
+            if (!measureOverlap(context, workload, computeQueue, copyQueue, "copy engine family (" + copyFamilyName + ")", result, overlap, error)) {
+                return false;
+            }
+        }
+    }
+    result.message = notes.join("; ");
+    return true;
+}
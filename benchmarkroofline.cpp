@@ -0,0 +1,174 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// FMA_COUNT controls the arithmetic intensity, two independent chains keep the kernels from being latency bound
+// globalIntensity reads and writes one float4 per work-item: 16 * FMA_COUNT + 4 flops for 32 bytes
+// localIntensity reads LOCAL_READS float4 values from local memory: 8 * FMA_COUNT + 4 flops per 16 bytes
+static const char* rooflineSource = R"(
+__kernel void globalIntensity(__global const float4* input, __global float4* output)
+{
+    const size_t gid = get_global_id(0);
+    float4 a = input[gid];
+    float4 b = a + 1.0f;
+    for (int i = 0; i < FMA_COUNT; i++) {
+        a = fma(a, (float4)(0.9999f), (float4)(0.0001f));
+        b = fma(b, (float4)(0.9999f), (float4)(0.0001f));
+    }
+    output[gid] = a + b;
+}
+
+__kernel void localIntensity(__global const float4* input, __global float4* output, __local float4* tile, uint mask)
+{
+    const size_t lid = get_local_id(0);
+    tile[lid] = input[get_global_id(0)];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    float4 sum = (float4)(0.0f);
+    for (uint r = 0; r < LOCAL_READS; r++) {
+        float4 v = tile[(lid + r) & mask];
+        for (int i = 0; i < FMA_COUNT; i++) {
+            v = fma(v, (float4)(0.9999f), (float4)(0.0001f));
+        }
+        sum += v;
+    }
+    output[get_global_id(0)] = sum;
+}
+)";
+
+// Covers memory bound kernels well below and compute bound kernels well above the ridge point of current devices
+static const int globalFmaCounts[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+// Each local work-item does LOCAL_READS times the work of a global one, so the local sweep stops at a lower FMA count
+static const int localFmaCounts[] = { 0, 1, 2, 4, 8, 16, 32, 64 };
+static const int localReads = 256;
+// Work-items are reduced for high intensities to keep the run time of the compute bound kernels reasonable
+static const double flopsPerRun = 2.0e9;
+static const size_t minGlobalSize = 64 * 1024;
+
+bool RooflineBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    size_t bufferSize = size_t(64) * 1024 * 1024;
+    while ((bufferSize > context.maxBufferSize()) && (bufferSize > 1024 * 1024)) {
+        bufferSize /= 2;
+    }
+    const size_t maxItems = bufferSize / sizeof(cl_float4);
+    // Buffers are initialized to avoid running into denormal or NaN slow paths on CPU implementations
+    std::vector<cl_float> hostData(bufferSize / sizeof(cl_float), 1.0f);
+    cl_mem inputBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bufferSize, hostData.data(), error);
+    if (!inputBuffer) {
+        return false;
+    }
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_WRITE_ONLY, bufferSize, nullptr, error);
+    if (!outputBuffer) {
+        return false;
+    }
+
+    RooflineModel model;
+    model.deviceName = context.device.identifier.name;
+    model.driverVersion = context.device.identifier.driverVersion;
+
+    for (int fmaCount : globalFmaCounts) {
+        cl_program program = context.buildProgram(rooflineSource, QString("-DFMA_COUNT=%1 -DLOCAL_READS=%2").arg(fmaCount).arg(localReads), error);
+        if (!program) {
+            return false;
+        }
+        cl_kernel kernel = context.createKernel(program, "globalIntensity", error);
+        if (!kernel) {
+            return false;
+        }
+        const double flopsPerItem = 16.0 * fmaCount + 4.0;
+        const double bytesPerItem = 2.0 * sizeof(cl_float4);
+        size_t globalSize = maxItems;
+        while ((globalSize * flopsPerItem > flopsPerRun) && (globalSize / 2 >= minGlobalSize)) {
+            globalSize /= 2;
+        }
+        _clSetKernelArg(kernel, 0, sizeof(cl_mem), &inputBuffer);
+        _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(kernel, 1, &globalSize, nullptr, timings, error)) {
+            return false;
+        }
+        const double time = timings.median();
+        if (time > 0.0) {
+            RooflinePoint point;
+            point.memory = "global";
+            point.intensity = flopsPerItem / bytesPerItem;
+            point.performance = globalSize * flopsPerItem / time;
+            model.points.push_back(point);
+        }
+    }
+
+    for (int fmaCount : localFmaCounts) {
+        cl_program program = context.buildProgram(rooflineSource, QString("-DFMA_COUNT=%1 -DLOCAL_READS=%2").arg(fmaCount).arg(localReads), error);
+        if (!program) {
+            return false;
+        }
+        cl_kernel kernel = context.createKernel(program, "localIntensity", error);
+        if (!kernel) {
+            return false;
+        }
+        // The tile is indexed with a mask, so the work group size needs to be a power of two
+        size_t maxLocalSize = 0;
+        _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxLocalSize, nullptr);
+        size_t localSize = 256;
+        while ((localSize > maxLocalSize) && (localSize > 1)) {
+            localSize /= 2;
+        }
+        const double flopsPerItem = localReads * (8.0 * fmaCount + 4.0);
+        const double bytesPerItem = localReads * double(sizeof(cl_float4));
+        // Local work-items are heavy enough that the 64k floor of the global sweep would exceed the run time budget,
+        // one work group per compute unit is still enough to occupy the device. maxItems and localSize are powers of two,
+        // so halving keeps the global size a multiple of the local size
+        const size_t minLocalGlobalSize = localSize * std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+        size_t globalSize = maxItems;
+        while ((globalSize * flopsPerItem > flopsPerRun) && (globalSize / 2 >= minLocalGlobalSize)) {
+            globalSize /= 2;
+        }
+        const cl_uint mask = cl_uint(localSize - 1);
+        _clSetKernelArg(kernel, 0, sizeof(cl_mem), &inputBuffer);
+        _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+        _clSetKernelArg(kernel, 2, localSize * sizeof(cl_float4), nullptr);
+        _clSetKernelArg(kernel, 3, sizeof(cl_uint), &mask);
+        BenchmarkTimings timings;
+        if (!context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error)) {
+            return false;
+        }
+        const double time = timings.median();
+        if (time > 0.0) {
+            RooflinePoint point;
+            point.memory = "local";
+            point.intensity = flopsPerItem / bytesPerItem;
+            point.performance = globalSize * flopsPerItem / time;
+            model.points.push_back(point);
+        }
+    }
+
+    model.deriveCeilings();
+    result.addValue("Compute ceiling", model.computeCeiling, "GFLOPS");
+    result.addValue("Memory ceiling", "global memory", model.globalMemoryBandwidth, "GB/s");
+    result.addValue("Memory ceiling", "local memory", model.localMemoryBandwidth, "GB/s");
+    result.addValue("Ridge point", "global memory", model.ridgePoint("global"), "flop/byte");
+    result.addValue("Ridge point", "local memory", model.ridgePoint("local"), "flop/byte");
+    for (auto& point : model.points) {
+        result.addValue("Measured performance", QString("%1 memory, %2 flop/byte").arg(point.memory).arg(point.intensity, 0, 'g', 4), point.performance, "GFLOPS");
+    }
+    context.results.roofline = model;
+    return true;
+}
@@ -0,0 +1,224 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "benchmark.h"
+
+// Validated element wise addition of two float buffers, mostly a sanity check for the benchmark engine
+class VectorAddBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "vectoradd"; }
+    QString name() override { return "Vector addition"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Achievable global memory bandwidth for STREAM like kernels (copy, scale, add, triad)
+// Also sweeps buffer sizes, vector widths, strides and coalesced versus scattered gathers
+class BandwidthBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "bandwidth"; }
+    QString name() override { return "Global memory bandwidth"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Host to device and device to host transfers with read/write, pinned staging memory and mapped buffers
+// Zero-copy mapping is additionally measured on devices sharing memory with the host
+class TransferBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "transfer"; }
+    QString name() override { return "Host device transfers"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Per dispatch overhead of empty kernels: enqueue cost, profiling gaps, clFinish and event callback round trips and batch throughput
+// Run for the in-order queue and, if supported by the device, an out-of-order queue
+class LatencyBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "latency"; }
+    QString name() override { return "Kernel launch latency"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Peak arithmetic throughput of generated mad chains for floating point and integer types at all vector widths
+class ComputeBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "compute"; }
+    QString name() override { return "Arithmetic throughput"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Local memory bandwidth versus stride (bank conflicts and estimated bank count), barrier cost and local versus global latency
+class LocalMemoryBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "localmemory"; }
+    QString name() override { return "Local memory"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Global and local atomic add and compare exchange throughput at low, medium and full contention
+// Run for each memory order and scope combination advertised by CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES
+class AtomicsBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "atomics"; }
+    QString name() override { return "Atomics"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Pointer chase latencies for stride and working set sweeps, used to infer cache levels, their sizes and the line size
+// Inferred values are shown next to the ones reported by the device, with discrepancies flagged
+class CacheBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "cache"; }
+    QString name() override { return "Cache hierarchy"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Program build times for representative kernels with common build options and all supported OpenCL C versions,
+// compared against reloading binaries from the on-disk program binary cache and building SPIR-V with clCreateProgramWithIL
+class BuildBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "buildtime"; }
+    QString name() override { return "Program build time"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Write and sampler read throughput (nearest/linear filtering, normalized/unnormalized coordinates) for all supported 2D image formats,
+// compared against buffer reads and writes with the same element size
+class ImageBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "images"; }
+    QString name() override { return "Image formats"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+    // Name of the values reported for an image format, used to match results with the image format list
+    static QString formatName(const cl_image_format& format);
+};
+
+// Verifies each advertised shared virtual memory mode (core or cl_arm_shared_virtual_memory) with pointer chases over host built lists,
+// plus map/unmap cost for coarse-grain buffers and host-device atomic ping-pong latency for fine-grain buffers
+class SvmBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "svm"; }
+    QString name() override { return "Shared virtual memory"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Sub-group broadcast, shuffle, reduce and scan throughput at each supported sub-group size (cl_intel_required_subgroup_size) or the one chosen by the implementation,
+// plus work-group collective functions, each compared against a local memory implementation of the same operation
+class SubGroupBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "subgroups"; }
+    QString name() override { return "Sub-group operations"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Kernel and transfer throughput scaling across one to eight queues (and across cl_intel_command_queue_families queue families),
+// plus the overlap of kernels and transfers on separate queues, all reconstructed from the profiling timestamps of the commands
+class QueuesBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "queues"; }
+    QString name() override { return "Multi-queue concurrency"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// cl_khr_integer_dot_product dot and dot_acc_sat throughput for unsigned, signed and mixed 8-bit vectors and packed 4x8-bit inputs,
+// compared against manual multiply-adds and the acceleration properties reported by the device
+class DotProductBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "dotproduct"; }
+    QString name() override { return "Integer dot product"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Latency and dispatch rate of short kernel sequences recorded once into a cl_khr_command_buffer and replayed,
+// compared against enqueueing the same sequence directly
+class CommandBufferBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "commandbuffer"; }
+    QString name() override { return "Command buffers"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Per child launch overhead of device-side enqueue against host enqueues, a recursive tree reduction launching its passes from the device
+// against host-driven passes, and child launch throughput for device queue sizes up to CL_DEVICE_QUEUE_ON_DEVICE_MAX_SIZE
+class DeviceEnqueueBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "deviceenqueue"; }
+    QString name() override { return "Device-side enqueue"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Creates sub-devices for each supported partition scheme (equally, by counts, by affinity domain) and probes them recursively for the partition tree
+// stored with the device, then compares compute and memory throughput of each partition alone and with all partitions running concurrently
+class PartitionBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "partitions"; }
+    QString name() override { return "Sub-device partitioning"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Sweep of kernels with controlled arithmetic intensity on global and local memory, the measured compute and memory ceilings
+// are stored with the device as its roofline model
+class RooflineBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "roofline"; }
+    QString name() override { return "Roofline model"; }
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+// Correlation of the device timer with the host timer (offset, drift, query cost) and a check of the profiling timer resolution,
+// the calibration is stored with the device so profiling timestamps can be mapped to host time
+class TimerBenchmark : public Benchmark
+{
+public:
+    QString id() override { return "timers"; }
+    QString name() override { return "Timer calibration"; }
+    bool supported(BenchmarkContext& context, QString& reason) override;
+    bool run(BenchmarkContext& context, BenchmarkResult& result, QString& error) override;
+};
+
+#endif
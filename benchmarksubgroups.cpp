@@ -0,0 +1,419 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+// Each work item runs a dependent chain of collective operations on an integer, so results can't be hoisted and there are no floating point special cases
+// SUB_GROUPS, SHUFFLE (shuffle function), REQD_SUB_GROUP_SIZE and WORK_GROUP_COLLECTIVES are passed as build options
+// The local memory kernels implement the same operations for segments of the work group with barriers, segment needs to be a power of two
+static const char* subGroupsSource = R"(
+#if defined(SUB_GROUPS) && defined(cl_khr_subgroups)
+#pragma OPENCL EXTENSION cl_khr_subgroups : enable
+#endif
+#if defined(SHUFFLE) && defined(cl_khr_subgroup_shuffle)
+#pragma OPENCL EXTENSION cl_khr_subgroup_shuffle : enable
+#endif
+#if defined(SUB_GROUPS) && defined(cl_intel_subgroups)
+#pragma OPENCL EXTENSION cl_intel_subgroups : enable
+#endif
+
+#ifdef REQD_SUB_GROUP_SIZE
+#define SUB_GROUP_ATTRIBUTE __attribute__((intel_reqd_sub_group_size(REQD_SUB_GROUP_SIZE)))
+#else
+#define SUB_GROUP_ATTRIBUTE
+#endif
+
+#ifdef SUB_GROUPS
+SUB_GROUP_ATTRIBUTE __kernel void subGroupSize(__global uint* output)
+{
+    if (get_global_id(0) == 0) {
+        output[0] = get_max_sub_group_size();
+    }
+}
+
+SUB_GROUP_ATTRIBUTE __kernel void subGroupBroadcast(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = sub_group_broadcast(value, 0) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+
+#ifdef SHUFFLE
+SUB_GROUP_ATTRIBUTE __kernel void subGroupShuffle(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    const uint neighbour = get_sub_group_local_id() ^ 1;
+    for (int i = 0; i < iterations; i++) {
+        value = SHUFFLE(value, neighbour) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+#endif
+
+SUB_GROUP_ATTRIBUTE __kernel void subGroupReduce(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = sub_group_reduce_add(value) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+
+SUB_GROUP_ATTRIBUTE __kernel void subGroupScan(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = sub_group_scan_inclusive_add(value) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+#endif
+
+#ifdef WORK_GROUP_COLLECTIVES
+__kernel void workGroupBroadcast(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = work_group_broadcast(value, 0) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+
+__kernel void workGroupReduce(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = work_group_reduce_add(value) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+
+__kernel void workGroupScan(__global uint* output, const int iterations)
+{
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        value = work_group_scan_inclusive_add(value) + 1;
+    }
+    output[get_global_id(0)] = value;
+}
+#endif
+
+__kernel void localBroadcast(__global uint* output, __local uint* scratch, const uint segment, const int iterations)
+{
+    const uint lid = get_local_id(0);
+    const uint first = lid & ~(segment - 1);
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        scratch[lid] = value;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        value = scratch[first] + 1;
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    output[get_global_id(0)] = value;
+}
+
+__kernel void localShuffle(__global uint* output, __local uint* scratch, const uint segment, const int iterations)
+{
+    const uint lid = get_local_id(0);
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        scratch[lid] = value;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        value = scratch[lid ^ 1] + 1;
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    output[get_global_id(0)] = value;
+}
+
+__kernel void localReduce(__global uint* output, __local uint* scratch, const uint segment, const int iterations)
+{
+    const uint lid = get_local_id(0);
+    const uint first = lid & ~(segment - 1);
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        scratch[lid] = value;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for (uint offset = segment / 2; offset > 0; offset >>= 1) {
+            if ((lid & (segment - 1)) < offset) {
+                scratch[lid] += scratch[lid + offset];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+        value = scratch[first] + 1;
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    output[get_global_id(0)] = value;
+}
+
+__kernel void localScan(__global uint* output, __local uint* scratch, const uint segment, const int iterations)
+{
+    const uint lid = get_local_id(0);
+    uint value = get_global_id(0);
+    for (int i = 0; i < iterations; i++) {
+        scratch[lid] = value;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for (uint offset = 1; offset < segment; offset <<= 1) {
+            const uint add = ((lid & (segment - 1)) >= offset) ? scratch[lid - offset] : 0;
+            barrier(CLK_LOCAL_MEM_FENCE);
+            scratch[lid] += add;
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+        value = scratch[lid] + 1;
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    output[get_global_id(0)] = value;
+}
+)";
+
+struct CollectiveOperation
+{
+    const char* name;
+    const char* subGroupKernel;
+    // Null if there is no work-group collective for this operation
+    const char* workGroupKernel;
+    const char* localKernel;
+};
+
+static const CollectiveOperation collectiveOperations[] = {
+    { "broadcast", "subGroupBroadcast", "workGroupBroadcast", "localBroadcast" },
+    { "shuffle", "subGroupShuffle", nullptr, "localShuffle" },
+    { "reduce", "subGroupReduce", "workGroupReduce", "localReduce" },
+    { "scan", "subGroupScan", "workGroupScan", "localScan" },
+};
+
+static const cl_int collectiveIterations = 256;
+
+static bool subGroupsSupported(BenchmarkContext& context)
+{
+    return context.device.extensionSupported("cl_khr_subgroups") || context.device.extensionSupported("cl_intel_subgroups") ||
+        ((context.device.clVersionMajor >= 3) && (context.deviceValue<cl_uint>(CL_DEVICE_MAX_NUM_SUB_GROUPS) > 0));
+}
+
+static bool workGroupCollectivesSupported(BenchmarkContext& context)
+{
+    // Mandatory for OpenCL 2.x, optional for OpenCL 3.0
+    return (context.device.clVersionMajor == 2) ||
+        ((context.device.clVersionMajor >= 3) && (context.deviceValue<cl_bool>(CL_DEVICE_WORK_GROUP_COLLECTIVE_FUNCTIONS_SUPPORT) == CL_TRUE));
+}
+
+// Throughput in operations per work item and iteration
+static bool measureCollective(BenchmarkContext& context, cl_kernel kernel, size_t globalSize, size_t localSize, double& throughput, QString& error)
+{
+    BenchmarkTimings timings;
+    if (!context.timeKernel(kernel, 1, &globalSize, &localSize, timings, error)) {
+        return false;
+    }
+    throughput = (timings.median() > 0.0) ? (double(globalSize) * collectiveIterations) / timings.median() : 0.0;
+    return true;
+}
+
+// Measures the local memory implementation of an operation for segments of the given size
+static bool measureLocal(BenchmarkContext& context, cl_kernel kernel, size_t globalSize, size_t localSize, cl_uint segment, double& throughput, QString& error)
+{
+    _clSetKernelArg(kernel, 1, localSize * sizeof(cl_uint), nullptr);
+    _clSetKernelArg(kernel, 2, sizeof(cl_uint), &segment);
+    _clSetKernelArg(kernel, 3, sizeof(cl_int), &collectiveIterations);
+    return measureCollective(context, kernel, globalSize, localSize, throughput, error);
+}
+
+bool SubGroupBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (!subGroupsSupported(context) && !workGroupCollectivesSupported(context)) {
+        reason = "Device supports neither sub-groups nor work-group collective functions";
+        return false;
+    }
+    return true;
+}
+
+bool SubGroupBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const bool subGroups = subGroupsSupported(context);
+    const bool workGroupCollectives = workGroupCollectivesSupported(context);
+    QString shuffleFunction;
+    if (context.device.extensionSupported("cl_khr_subgroup_shuffle")) {
+        shuffleFunction = "sub_group_shuffle";
+    } else if (context.device.extensionSupported("cl_intel_subgroups")) {
+        shuffleFunction = "intel_sub_group_shuffle";
+    }
+    QString languageVersion;
+    if (context.device.clVersionMajor >= 3) {
+        languageVersion = "-cl-std=CL3.0";
+    } else if (context.device.clVersionMajor == 2) {
+        languageVersion = "-cl-std=CL2.0";
+    }
+
+    // With cl_intel_required_subgroup_size, all supported sub-group sizes can be requested for a kernel, otherwise the implementation chooses
+    std::vector<size_t> requiredSizes;
+    if (subGroups && context.device.extensionSupported("cl_intel_required_subgroup_size")) {
+        size_t valueSize = 0;
+        _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_SUB_GROUP_SIZES_INTEL, 0, nullptr, &valueSize);
+        requiredSizes.resize(valueSize / sizeof(size_t));
+        _clGetDeviceInfo(context.device.deviceId, CL_DEVICE_SUB_GROUP_SIZES_INTEL, valueSize, requiredSizes.data(), nullptr);
+    }
+    if (requiredSizes.empty()) {
+        requiredSizes.push_back(0);
+    }
+
+    const cl_uint computeUnits = std::max(context.deviceValue<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS), 1u);
+    const size_t maxLocalSize = std::min(context.deviceValue<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE), size_t(256));
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_READ_WRITE, maxLocalSize * computeUnits * 8 * sizeof(cl_uint), nullptr, error);
+    if (!outputBuffer) {
+        return false;
+    }
+
+    QStringList failedSizes;
+    bool workGroupMeasured = !workGroupCollectives;
+    for (size_t requiredSize : requiredSizes) {
+        QString options = languageVersion;
+        if (subGroups) {
+            options += " -DSUB_GROUPS";
+            if (!shuffleFunction.isEmpty()) {
+                options += " -DSHUFFLE=" + shuffleFunction;
+            }
+            if (requiredSize > 0) {
+                options += QString(" -DREQD_SUB_GROUP_SIZE=%1").arg(requiredSize);
+            }
+        }
+        if (!workGroupMeasured) {
+            options += " -DWORK_GROUP_COLLECTIVES";
+        }
+        cl_program program = context.buildProgram(subGroupsSource, options.trimmed(), error);
+        if (!program) {
+            if (requiredSize > 0) {
+                // Advertised but not supported by the compiler, keep going with the other sizes
+                qWarning() << "Could not build sub-group program for size" << requiredSize << ":" << error;
+                failedSizes.append(QString::number(requiredSize));
+                continue;
+            }
+            return false;
+        }
+
+        // All variants use the same work group size, limited by the kernel that supports the smallest one
+        std::vector<std::pair<const char*, cl_kernel>> kernels;
+        std::vector<const char*> kernelNames = { "localBroadcast", "localShuffle", "localReduce", "localScan" };
+        if (subGroups) {
+            kernelNames.push_back("subGroupSize");
+            for (auto& operation : collectiveOperations) {
+                if ((QString(operation.name) != "shuffle") || !shuffleFunction.isEmpty()) {
+                    kernelNames.push_back(operation.subGroupKernel);
+                }
+            }
+        }
+        if (!workGroupMeasured) {
+            for (auto& operation : collectiveOperations) {
+                if (operation.workGroupKernel) {
+                    kernelNames.push_back(operation.workGroupKernel);
+                }
+            }
+        }
+        size_t localSize = maxLocalSize;
+        for (const char* kernelName : kernelNames) {
+            cl_kernel kernel = context.createKernel(program, kernelName, error);
+            if (!kernel) {
+                return false;
+            }
+            size_t kernelWorkGroupSize = 0;
+            _clGetKernelWorkGroupInfo(kernel, context.device.deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &kernelWorkGroupSize, nullptr);
+            localSize = std::min(localSize, std::max(kernelWorkGroupSize, size_t(1)));
+            _clSetKernelArg(kernel, 0, sizeof(cl_mem), &outputBuffer);
+            kernels.push_back({ kernelName, kernel });
+        }
+        // Power of two, so local memory segments always cover whole sub-groups
+        while (localSize & (localSize - 1)) {
+            localSize &= localSize - 1;
+        }
+        const size_t globalSize = localSize * computeUnits * 8;
+        auto findKernel = [&kernels](const char* name) -> cl_kernel {
+            for (auto& kernel : kernels) {
+                if (QString(kernel.first) == name) {
+                    return kernel.second;
+                }
+            }
+            return nullptr;
+        };
+
+        if (subGroups) {
+            cl_kernel sizeKernel = findKernel("subGroupSize");
+            cl_uint subGroupSize = 0;
+            cl_int status = _clEnqueueNDRangeKernel(context.queue, sizeKernel, 1, nullptr, &localSize, &localSize, 0, nullptr, nullptr);
+            if (status == CL_SUCCESS) {
+                status = _clEnqueueReadBuffer(context.queue, outputBuffer, CL_TRUE, 0, sizeof(cl_uint), &subGroupSize, 0, nullptr, nullptr);
+            }
+            if (status != CL_SUCCESS) {
+                error = "Could not read sub-group size: " + utils::errorString(status);
+                return false;
+            }
+            const QString detail = (requiredSize > 0) ? QString("size %1").arg(subGroupSize) : QString("size %1, chosen by implementation").arg(subGroupSize);
+            const bool localComparison = (subGroupSize >= 2) && ((subGroupSize & (subGroupSize - 1)) == 0) && (subGroupSize <= localSize);
+            for (auto& operation : collectiveOperations) {
+                cl_kernel kernel = findKernel(operation.subGroupKernel);
+                if (!kernel) {
+                    continue;
+                }
+                _clSetKernelArg(kernel, 1, sizeof(cl_int), &collectiveIterations);
+                double throughput = 0.0;
+                if (!measureCollective(context, kernel, globalSize, localSize, throughput, error)) {
+                    return false;
+                }
+                result.addValue(QString("Sub-group ") + operation.name, detail, throughput, "Gops/s");
+                if (localComparison) {
+                    double localThroughput = 0.0;
+                    if (!measureLocal(context, findKernel(operation.localKernel), globalSize, localSize, subGroupSize, localThroughput, error)) {
+                        return false;
+                    }
+                    result.addValue(QString("Local memory ") + operation.name, QString("segments of %1").arg(subGroupSize), localThroughput, "Gops/s");
+                    if (localThroughput > 0.0) {
+                        result.addValue(QString("Sub-group ") + operation.name, detail + ", relative to local memory", throughput / localThroughput, "x");
+                    }
+                }
+            }
+        }
+
+        // Work-group collectives don't depend on the sub-group size, so they're only measured with the first program
+        if (!workGroupMeasured) {
+            const QString detail = QString("%1 work items").arg(localSize);
+            for (auto& operation : collectiveOperations) {
+                if (!operation.workGroupKernel) {
+                    continue;
+                }
+                cl_kernel kernel = findKernel(operation.workGroupKernel);
+                _clSetKernelArg(kernel, 1, sizeof(cl_int), &collectiveIterations);
+                double throughput = 0.0;
+                double localThroughput = 0.0;
+                if (!measureCollective(context, kernel, globalSize, localSize, throughput, error) ||
+                    !measureLocal(context, findKernel(operation.localKernel), globalSize, localSize, cl_uint(localSize), localThroughput, error)) {
+                    return false;
+                }
+                result.addValue(QString("Work-group ") + operation.name, detail, throughput, "Gops/s");
+                result.addValue(QString("Local memory ") + operation.name, QString("segments of %1").arg(localSize), localThroughput, "Gops/s");
+                if (localThroughput > 0.0) {
+                    result.addValue(QString("Work-group ") + operation.name, detail + ", relative to local memory", throughput / localThroughput, "x");
+                }
+            }
+            workGroupMeasured = true;
+        }
+    }
+    if (!failedSizes.isEmpty()) {
+        result.message = "Advertised sub-group sizes that could not be built: " + failedSizes.join(", ");
+    }
+    return true;
+}
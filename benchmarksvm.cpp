@@ -0,0 +1,439 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <atomic>
+#include <new>
+
+// Linked list nodes built on the host, the device follows the host pointers directly
+static const char* svmSource = R"(
+typedef struct Node {
+    __global struct Node* next;
+    uint value;
+    uint padding;
+} Node;
+
+__kernel void chaseList(__global Node* head, __global ulong* output, const int steps)
+{
+    if (get_global_id(0) == 0) {
+        __global Node* node = head;
+        ulong sum = 0;
+        for (int i = 0; i < steps; i++) {
+            sum += node->value;
+            node = node->next;
+        }
+        output[0] = sum;
+    }
+}
+
+// Same chase with indices in a regular buffer, as a baseline for the SVM pointer chases
+__kernel void chaseIndices(__global const uint* next, __global ulong* output, const int steps)
+{
+    if (get_global_id(0) == 0) {
+        uint index = 0;
+        ulong sum = 0;
+        for (int i = 0; i < steps; i++) {
+            sum += index;
+            index = next[index];
+        }
+        output[0] = sum;
+    }
+}
+
+#ifdef SVM_ATOMICS
+#if defined(__opencl_c_atomic_scope_all_devices) || (__OPENCL_C_VERSION__ < 300)
+#define PING_PONG_SCOPE memory_scope_all_svm_devices
+#else
+#define PING_PONG_SCOPE memory_scope_device
+#endif
+
+// The host sets odd values and the device answers with the next even value
+// Spinning is limited, so the kernel always terminates even if the host side never arrives
+__kernel void pingPong(__global atomic_int* flag, __global ulong* output, const int iterations)
+{
+    int completed = 0;
+    for (int i = 0; i < iterations; i++) {
+        int spins = 0;
+        while ((atomic_load_explicit(flag, memory_order_acquire, PING_PONG_SCOPE) != 2 * i + 1) && (spins < MAX_SPINS)) {
+            spins++;
+        }
+        if (spins >= MAX_SPINS) {
+            break;
+        }
+        atomic_store_explicit(flag, 2 * i + 2, memory_order_release, PING_PONG_SCOPE);
+        completed++;
+    }
+    output[0] = completed;
+}
+#endif
+)";
+
+// Host side layout of the list nodes, matches the device side as long as host and device pointers have the same size
+struct SvmNode
+{
+    SvmNode* next;
+    cl_uint value;
+    cl_uint padding;
+};
+
+// Core (OpenCL 2.0) or cl_arm_shared_virtual_memory entry points, both share the same signatures
+struct SvmFunctions
+{
+    PFN_clSVMAlloc allocate = nullptr;
+    PFN_clSVMFree release = nullptr;
+    PFN_clSetKernelArgSVMPointer setKernelArg = nullptr;
+    PFN_clEnqueueSVMMap enqueueMap = nullptr;
+    PFN_clEnqueueSVMUnmap enqueueUnmap = nullptr;
+};
+
+// Frees the allocation when going out of scope, so early returns don't leak SVM memory
+struct SvmAllocation
+{
+    const SvmFunctions& functions;
+    BenchmarkContext& context;
+    void* ptr = nullptr;
+    SvmAllocation(const SvmFunctions& functions, BenchmarkContext& context, cl_svm_mem_flags flags, size_t size) : functions(functions), context(context)
+    {
+        ptr = functions.allocate(context.context, flags, size, 0);
+    }
+    ~SvmAllocation()
+    {
+        if (ptr) {
+            _clFinish(context.queue);
+            functions.release(context.context, ptr);
+        }
+    }
+};
+
+static const cl_int chaseSteps = 65536;
+
+static bool armSvm(BenchmarkContext& context)
+{
+    return (context.device.clVersionMajor < 2) && context.device.extensionSupported("cl_arm_shared_virtual_memory");
+}
+
+static cl_device_svm_capabilities svmCapabilities(BenchmarkContext& context)
+{
+    if (armSvm(context)) {
+        return context.deviceValue<cl_device_svm_capabilities>(CL_DEVICE_SVM_CAPABILITIES_ARM);
+    }
+    return (context.device.clVersionMajor >= 2) ? context.deviceValue<cl_device_svm_capabilities>(CL_DEVICE_SVM_CAPABILITIES) : 0;
+}
+
+static SvmFunctions svmFunctions(BenchmarkContext& context)
+{
+    SvmFunctions functions;
+    if (armSvm(context)) {
+        if (_clGetExtensionFunctionAddressForPlatform) {
+            cl_platform_id platform = context.device.platform->platformId;
+            functions.allocate = reinterpret_cast<PFN_clSVMAlloc>(_clGetExtensionFunctionAddressForPlatform(platform, "clSVMAllocARM"));
+            functions.release = reinterpret_cast<PFN_clSVMFree>(_clGetExtensionFunctionAddressForPlatform(platform, "clSVMFreeARM"));
+            functions.setKernelArg = reinterpret_cast<PFN_clSetKernelArgSVMPointer>(_clGetExtensionFunctionAddressForPlatform(platform, "clSetKernelArgSVMPointerARM"));
+            functions.enqueueMap = reinterpret_cast<PFN_clEnqueueSVMMap>(_clGetExtensionFunctionAddressForPlatform(platform, "clEnqueueSVMMapARM"));
+            functions.enqueueUnmap = reinterpret_cast<PFN_clEnqueueSVMUnmap>(_clGetExtensionFunctionAddressForPlatform(platform, "clEnqueueSVMUnmapARM"));
+        }
+    } else {
+        functions.allocate = _clSVMAlloc;
+        functions.release = _clSVMFree;
+        functions.setKernelArg = _clSetKernelArgSVMPointer;
+        functions.enqueueMap = _clEnqueueSVMMap;
+        functions.enqueueUnmap = _clEnqueueSVMUnmap;
+    }
+    return functions;
+}
+
+// Random cyclic list, walking it from the first node visits all nodes once
+static void buildList(SvmNode* nodes, cl_uint count)
+{
+    const std::vector<cl_uint> cycle = Benchmark::randomCycle(count);
+    for (cl_uint i = 0; i < count; i++) {
+        nodes[i].next = &nodes[cycle[i]];
+        nodes[i].value = i;
+        nodes[i].padding = 0;
+    }
+}
+
+// Runs the chase for the given number of steps and returns the sum of all visited values
+static bool runChase(BenchmarkContext& context, cl_kernel kernel, cl_mem outputBuffer, cl_int steps, cl_ulong& sum, QString& error)
+{
+    const size_t globalSize = 1;
+    _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &steps);
+    cl_int status = _clEnqueueNDRangeKernel(context.queue, kernel, 1, nullptr, &globalSize, &globalSize, 0, nullptr, nullptr);
+    if (status == CL_SUCCESS) {
+        status = _clEnqueueReadBuffer(context.queue, outputBuffer, CL_TRUE, 0, sizeof(cl_ulong), &sum, 0, nullptr, nullptr);
+    }
+    if (status != CL_SUCCESS) {
+        error = "Could not run pointer chase: " + utils::errorString(status);
+        return false;
+    }
+    return true;
+}
+
+// Walks all nodes once to verify that the device sees the same data as the host, then measures the latency per step
+static bool verifyAndTimeChase(BenchmarkContext& context, cl_kernel kernel, cl_mem outputBuffer, cl_uint count, bool& verified, double& latency, QString& error)
+{
+    cl_ulong sum = 0;
+    if (!runChase(context, kernel, outputBuffer, cl_int(count), sum, error)) {
+        return false;
+    }
+    verified = (sum == cl_ulong(count) * (count - 1) / 2);
+    if (!verified) {
+        return true;
+    }
+    const size_t globalSize = 1;
+    const cl_int noSteps = 0;
+    BenchmarkTimings baseTimings;
+    BenchmarkTimings chaseTimings;
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &noSteps);
+    if (!context.timeKernel(kernel, 1, &globalSize, &globalSize, baseTimings, error)) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &chaseSteps);
+    if (!context.timeKernel(kernel, 1, &globalSize, &globalSize, chaseTimings, error)) {
+        return false;
+    }
+    latency = std::max(chaseTimings.median() - baseTimings.median(), 0.0) / chaseSteps;
+    return true;
+}
+
+// Host and device take turns incrementing a flag in fine-grain SVM memory with atomics, returns the average round trip
+static bool pingPong(BenchmarkContext& context, const SvmFunctions& functions, cl_kernel kernel, cl_mem outputBuffer, bool& verified, double& roundTrip, QString& error)
+{
+    SvmAllocation allocation(functions, context, CL_MEM_READ_WRITE | CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_SVM_ATOMICS, sizeof(cl_int));
+    if (!allocation.ptr) {
+        error = "Could not allocate fine-grain SVM buffer with atomics";
+        return false;
+    }
+    std::atomic<cl_int>* flag = new (allocation.ptr) std::atomic<cl_int>(0);
+    const cl_int iterations = 1000;
+    const size_t globalSize = 1;
+    functions.setKernelArg(kernel, 0, allocation.ptr);
+    _clSetKernelArg(kernel, 1, sizeof(cl_mem), &outputBuffer);
+    _clSetKernelArg(kernel, 2, sizeof(cl_int), &iterations);
+    cl_int status = _clEnqueueNDRangeKernel(context.queue, kernel, 1, nullptr, &globalSize, &globalSize, 0, nullptr, nullptr);
+    if (status != CL_SUCCESS) {
+        error = "Could not enqueue ping-pong kernel: " + utils::errorString(status);
+        return false;
+    }
+    _clFlush(context.queue);
+
+    bool responded = true;
+    auto start = std::chrono::steady_clock::now();
+    for (cl_int i = 0; (i < iterations) && responded; i++) {
+        // The first round trip also contains the kernel launch
+        if (i == 1) {
+            start = std::chrono::steady_clock::now();
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds((i == 0) ? 5 : 1);
+        flag->store(2 * i + 1, std::memory_order_release);
+        while (flag->load(std::memory_order_acquire) != 2 * i + 2) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                responded = false;
+                break;
+            }
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    cl_ulong completed = 0;
+    status = _clEnqueueReadBuffer(context.queue, outputBuffer, CL_TRUE, 0, sizeof(cl_ulong), &completed, 0, nullptr, nullptr);
+    if (status != CL_SUCCESS) {
+        error = "Could not read ping-pong result: " + utils::errorString(status);
+        return false;
+    }
+    verified = responded && (completed == cl_ulong(iterations));
+    roundTrip = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / (iterations - 1);
+    return true;
+}
+
+bool SvmBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if (svmCapabilities(context) == 0) {
+        reason = "Device does not support shared virtual memory";
+        return false;
+    }
+    const SvmFunctions functions = svmFunctions(context);
+    if (!functions.allocate || !functions.release || !functions.setKernelArg || !functions.enqueueMap || !functions.enqueueUnmap) {
+        reason = "SVM entry points not available";
+        return false;
+    }
+    // Pointers stored by the host need to be valid device pointers
+    if (context.deviceValue<cl_uint>(CL_DEVICE_ADDRESS_BITS) != sizeof(void*) * 8) {
+        reason = "Device and host pointer sizes differ";
+        return false;
+    }
+    return true;
+}
+
+bool SvmBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    const cl_device_svm_capabilities capabilities = svmCapabilities(context);
+    const SvmFunctions functions = svmFunctions(context);
+    // Host-device atomics need the OpenCL C 2.0 atomics
+    const bool atomics = (capabilities & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) && (capabilities & CL_DEVICE_SVM_ATOMICS) && (context.device.clVersionMajor >= 2);
+
+    QString options = (context.device.clVersionMajor >= 3) ? "-cl-std=CL3.0" : (context.device.clVersionMajor == 2) ? "-cl-std=CL2.0" : "";
+    if (atomics) {
+        options += " -DSVM_ATOMICS -DMAX_SPINS=16777216";
+    }
+    cl_program program = context.buildProgram(svmSource, options, error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel chaseListKernel = context.createKernel(program, "chaseList", error);
+    cl_kernel chaseIndicesKernel = context.createKernel(program, "chaseIndices", error);
+    cl_mem outputBuffer = context.createBuffer(CL_MEM_READ_WRITE, sizeof(cl_ulong), nullptr, error);
+    if (!chaseListKernel || !chaseIndicesKernel || !outputBuffer) {
+        return false;
+    }
+
+    cl_uint nodeCount = 1024 * 1024;
+    while ((nodeCount * sizeof(SvmNode) > context.maxBufferSize()) && (nodeCount > 1024)) {
+        nodeCount /= 2;
+    }
+    const size_t listSize = nodeCount * sizeof(SvmNode);
+    QStringList verifiedModes;
+    QStringList failedModes;
+    QStringList untestedModes;
+    auto addChaseResult = [&](const QString& mode, bool verified, double latency) {
+        if (verified) {
+            verifiedModes.append(mode);
+            result.addValue(mode, "pointer chase latency", latency, "ns");
+        } else {
+            failedModes.append(mode);
+        }
+    };
+
+    // Baseline with indices in a regular device buffer
+    std::vector<cl_uint> cycle = randomCycle(nodeCount);
+    cl_mem indexBuffer = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, nodeCount * sizeof(cl_uint), cycle.data(), error);
+    if (!indexBuffer) {
+        return false;
+    }
+    _clSetKernelArg(chaseIndicesKernel, 0, sizeof(cl_mem), &indexBuffer);
+    bool verified = false;
+    double latency = 0.0;
+    if (!verifyAndTimeChase(context, chaseIndicesKernel, outputBuffer, nodeCount, verified, latency, error)) {
+        return false;
+    }
+    result.addValue("Device buffer", "index chase latency", latency, "ns");
+
+    if (capabilities & CL_DEVICE_SVM_COARSE_GRAIN_BUFFER) {
+        SvmAllocation allocation(functions, context, CL_MEM_READ_WRITE, listSize);
+        if (!allocation.ptr) {
+            error = "Could not allocate coarse-grain SVM buffer";
+            return false;
+        }
+        // Coarse-grain memory may only be accessed by the host while mapped
+        cl_int status = functions.enqueueMap(context.queue, CL_TRUE, CL_MAP_WRITE, allocation.ptr, listSize, 0, nullptr, nullptr);
+        if (status == CL_SUCCESS) {
+            buildList(static_cast<SvmNode*>(allocation.ptr), nodeCount);
+            status = functions.enqueueUnmap(context.queue, allocation.ptr, 0, nullptr, nullptr);
+        }
+        if (status != CL_SUCCESS) {
+            error = "Could not map coarse-grain SVM buffer: " + utils::errorString(status);
+            return false;
+        }
+        functions.setKernelArg(chaseListKernel, 0, allocation.ptr);
+        if (!verifyAndTimeChase(context, chaseListKernel, outputBuffer, nodeCount, verified, latency, error)) {
+            return false;
+        }
+        addChaseResult("Coarse-grain buffer", verified, latency);
+
+        for (size_t mapSize : { size_t(4096), size_t(1024 * 1024), listSize }) {
+            BenchmarkTimings timings;
+            const bool mapSuccess = context.timeHost([&]() {
+                cl_int mapStatus = functions.enqueueMap(context.queue, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, allocation.ptr, mapSize, 0, nullptr, nullptr);
+                if (mapStatus != CL_SUCCESS) {
+                    return mapStatus;
+                }
+                mapStatus = functions.enqueueUnmap(context.queue, allocation.ptr, 0, nullptr, nullptr);
+                if (mapStatus != CL_SUCCESS) {
+                    return mapStatus;
+                }
+                return _clFinish(context.queue);
+            }, timings, error);
+            if (!mapSuccess) {
+                return false;
+            }
+            result.addValue("Coarse-grain buffer map/unmap", sizeString(mapSize), timings.median() / 1000.0, "us");
+        }
+    }
+
+    if (capabilities & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) {
+        // Fine-grain memory can be written by the host without mapping
+        SvmAllocation allocation(functions, context, CL_MEM_READ_WRITE | CL_MEM_SVM_FINE_GRAIN_BUFFER, listSize);
+        if (!allocation.ptr) {
+            error = "Could not allocate fine-grain SVM buffer";
+            return false;
+        }
+        buildList(static_cast<SvmNode*>(allocation.ptr), nodeCount);
+        functions.setKernelArg(chaseListKernel, 0, allocation.ptr);
+        if (!verifyAndTimeChase(context, chaseListKernel, outputBuffer, nodeCount, verified, latency, error)) {
+            return false;
+        }
+        addChaseResult("Fine-grain buffer", verified, latency);
+    }
+
+    if (capabilities & CL_DEVICE_SVM_FINE_GRAIN_SYSTEM) {
+        // Any host allocation can be passed to the device
+        std::vector<SvmNode> nodes(nodeCount);
+        buildList(nodes.data(), nodeCount);
+        functions.setKernelArg(chaseListKernel, 0, nodes.data());
+        if (!verifyAndTimeChase(context, chaseListKernel, outputBuffer, nodeCount, verified, latency, error)) {
+            return false;
+        }
+        _clFinish(context.queue);
+        addChaseResult("Fine-grain system", verified, latency);
+    }
+
+    if (atomics) {
+        cl_kernel pingPongKernel = context.createKernel(program, "pingPong", error);
+        if (!pingPongKernel) {
+            return false;
+        }
+        double roundTrip = 0.0;
+        if (!pingPong(context, functions, pingPongKernel, outputBuffer, verified, roundTrip, error)) {
+            return false;
+        }
+        if (verified) {
+            verifiedModes.append("Atomics");
+            result.addValue("Atomics", "host-device ping-pong round trip", roundTrip / 1000.0, "us");
+        } else {
+            failedModes.append("Atomics");
+        }
+    } else if (capabilities & CL_DEVICE_SVM_ATOMICS) {
+        untestedModes.append("Atomics (requires fine-grain buffers and OpenCL C 2.0)");
+    }
+
+    QStringList messages;
+    if (!verifiedModes.isEmpty()) {
+        messages.append("Verified: " + verifiedModes.join(", "));
+    }
+    if (!failedModes.isEmpty()) {
+        messages.append("Advertised but not working: " + failedModes.join(", "));
+    }
+    if (!untestedModes.isEmpty()) {
+        messages.append("Not tested: " + untestedModes.join(", "));
+    }
+    result.message = messages.join("; ");
+    return true;
+}
@@ -0,0 +1,242 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <thread>
+
+static const char* timerSource = R"(
+__kernel void touch(__global uint* data)
+{
+    data[get_global_id(0)] = 0;
+}
+)";
+
+// Correlation samples are spread over a few seconds, so the drift of the device timer against the host timer becomes visible
+static const cl_uint correlationSamplesPerIteration = 4;
+static const std::chrono::milliseconds correlationInterval(50);
+static const cl_uint timerQueries = 1000;
+static const cl_uint profiledKernels = 256;
+
+// Granularity of the timestamps as the greatest common divisor of all non-zero differences (quantum)
+// The smallest difference (step) is kept as well, it may be a multiple of the quantum if the timer is queried slower than it ticks
+static void timestampGranularity(std::vector<cl_ulong> timestamps, quint64& quantum, quint64& step)
+{
+    std::sort(timestamps.begin(), timestamps.end());
+    quantum = 0;
+    step = 0;
+    for (size_t i = 1; i < timestamps.size(); i++) {
+        const quint64 difference = timestamps[i] - timestamps[i - 1];
+        if (difference == 0) {
+            continue;
+        }
+        if ((step == 0) || (difference < step)) {
+            step = difference;
+        }
+        quint64 a = quantum;
+        quint64 b = difference;
+        while (b != 0) {
+            const quint64 remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+        quantum = a;
+    }
+}
+
+// Compares an observed timer quantum against the reported resolution in both directions
+static void compareResolution(const QString& timer, quint64 quantum, quint64 reported, QStringList& messages)
+{
+    if ((quantum == 0) || (reported == 0) || (quantum == reported)) {
+        return;
+    }
+    messages.append(QString("%1 timestamps advance in steps of %2 ns, %3 than the reported resolution of %4 ns").arg(timer).arg(quantum).arg((quantum < reported) ? "finer" : "coarser").arg(reported));
+}
+
+static cl_ulong hostTimerResolution(BenchmarkContext& context)
+{
+    cl_ulong resolution = 0;
+    _clGetPlatformInfo(context.device.platform->platformId, CL_PLATFORM_HOST_TIMER_RESOLUTION, sizeof(cl_ulong), &resolution, nullptr);
+    return resolution;
+}
+
+bool TimerBenchmark::supported(BenchmarkContext& context, QString& reason)
+{
+    if ((context.device.clVersionMajor < 2) || ((context.device.clVersionMajor == 2) && (context.device.clVersionMinor < 1))) {
+        reason = "Device and host timer synchronization requires OpenCL 2.1";
+        return false;
+    }
+    if (!_clGetDeviceAndHostTimer || !_clGetHostTimer) {
+        reason = "clGetDeviceAndHostTimer is not available";
+        return false;
+    }
+    // Optional since OpenCL 3.0, signaled by a host timer resolution of zero
+    if (hostTimerResolution(context) == 0) {
+        reason = "Platform does not support device and host timer synchronization";
+        return false;
+    }
+    return true;
+}
+
+bool TimerBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    TimerCalibration calibration;
+    calibration.deviceName = context.device.identifier.name;
+    calibration.driverVersion = context.device.identifier.driverVersion;
+    calibration.reportedProfilingResolution = context.deviceValue<size_t>(CL_DEVICE_PROFILING_TIMER_RESOLUTION);
+    calibration.reportedHostResolution = hostTimerResolution(context);
+    const cl_device_id device = context.device.deviceId;
+
+    // Query cost, and the granularity of the host timer from back to back queries
+    std::vector<cl_ulong> hostTimestamps(timerQueries);
+    BenchmarkTimings hostTimerTimings;
+    BenchmarkTimings deviceAndHostTimerTimings;
+    for (uint32_t run = 0; run < context.settings.warmupIterations + context.settings.iterations; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& timestamp : hostTimestamps) {
+            const cl_int status = _clGetHostTimer(device, &timestamp);
+            if (status != CL_SUCCESS) {
+                error = "Could not read host timer: " + utils::errorString(status);
+                return false;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (run >= context.settings.warmupIterations) {
+            hostTimerTimings.samples.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / timerQueries);
+        }
+        start = std::chrono::steady_clock::now();
+        for (cl_uint i = 0; i < timerQueries; i++) {
+            cl_ulong deviceTimestamp = 0;
+            cl_ulong hostTimestamp = 0;
+            const cl_int status = _clGetDeviceAndHostTimer(device, &deviceTimestamp, &hostTimestamp);
+            if (status != CL_SUCCESS) {
+                error = "Could not read device and host timer: " + utils::errorString(status);
+                return false;
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        if (run >= context.settings.warmupIterations) {
+            deviceAndHostTimerTimings.samples.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / timerQueries);
+        }
+    }
+    calibration.hostTimerCost = hostTimerTimings.median();
+    calibration.deviceAndHostTimerCost = deviceAndHostTimerTimings.median();
+    timestampGranularity(hostTimestamps, calibration.observedHostQuantum, calibration.observedHostStep);
+
+    // Profiling timestamps of short kernels, each bracketed by device timer queries before the enqueue and after it finished
+    // The device timer uses the same timebase as profiling, so all timestamps of a command have to lie within its bracket
+    cl_program program = context.buildProgram(timerSource, "", error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel kernel = context.createKernel(program, "touch", error);
+    if (!kernel) {
+        return false;
+    }
+    cl_mem buffer = context.createBuffer(CL_MEM_WRITE_ONLY, sizeof(cl_uint), nullptr, error);
+    if (!buffer) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 0, sizeof(cl_mem), &buffer);
+    const size_t globalSize = 1;
+    std::vector<cl_ulong> profilingTimestamps;
+    cl_uint outsideBracket = 0;
+    cl_ulong maxBracketViolation = 0;
+    for (cl_uint i = 0; i < profiledKernels; i++) {
+        cl_ulong before = 0;
+        cl_ulong after = 0;
+        cl_ulong hostTimestamp = 0;
+        cl_event event = nullptr;
+        _clGetDeviceAndHostTimer(device, &before, &hostTimestamp);
+        cl_int status = _clEnqueueNDRangeKernel(context.queue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, &event);
+        if (status == CL_SUCCESS) {
+            status = _clFinish(context.queue);
+        }
+        _clGetDeviceAndHostTimer(device, &after, &hostTimestamp);
+        if (status != CL_SUCCESS) {
+            if (event) {
+                _clReleaseEvent(event);
+            }
+            error = "Could not run kernel: " + utils::errorString(status);
+            return false;
+        }
+        bool outside = false;
+        for (cl_profiling_info info : { CL_PROFILING_COMMAND_QUEUED, CL_PROFILING_COMMAND_SUBMIT, CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END }) {
+            cl_ulong timestamp = 0;
+            _clGetEventProfilingInfo(event, info, sizeof(cl_ulong), &timestamp, nullptr);
+            profilingTimestamps.push_back(timestamp);
+            if (timestamp < before) {
+                outside = true;
+                maxBracketViolation = std::max(maxBracketViolation, before - timestamp);
+            } else if (timestamp > after) {
+                outside = true;
+                maxBracketViolation = std::max(maxBracketViolation, timestamp - after);
+            }
+        }
+        _clReleaseEvent(event);
+        if (outside) {
+            outsideBracket++;
+        }
+    }
+    timestampGranularity(profilingTimestamps, calibration.observedProfilingQuantum, calibration.observedProfilingStep);
+
+    // Offset and drift, fitted over all correlation samples
+    const cl_uint correlationSamples = std::max(context.settings.iterations, 5u) * correlationSamplesPerIteration;
+    for (cl_uint i = 0; i < correlationSamples; i++) {
+        if (i > 0) {
+            std::this_thread::sleep_for(correlationInterval);
+        }
+        cl_ulong deviceTimestamp = 0;
+        cl_ulong hostTimestamp = 0;
+        const cl_int status = _clGetDeviceAndHostTimer(device, &deviceTimestamp, &hostTimestamp);
+        if (status != CL_SUCCESS) {
+            error = "Could not read device and host timer: " + utils::errorString(status);
+            return false;
+        }
+        TimerSample sample;
+        sample.device = deviceTimestamp;
+        sample.host = hostTimestamp;
+        calibration.samples.push_back(sample);
+    }
+    calibration.fit();
+
+    const double duration = double(calibration.samples.back().host - calibration.samples.front().host) / 1.0e9;
+    result.addValue("Device minus host timer", "at first sample", calibration.offset() / 1000.0, "us");
+    result.addValue("Device timer drift", QString("over %1 s").arg(duration, 0, 'f', 1), calibration.drift(), "ppm");
+    result.addValue("Correlation residual", "standard deviation from the fitted line", calibration.residual, "ns");
+    result.addValue("Query cost", "clGetHostTimer", calibration.hostTimerCost, "ns");
+    result.addValue("Query cost", "clGetDeviceAndHostTimer", calibration.deviceAndHostTimerCost, "ns");
+    result.addValue("Host timer resolution", "reported", double(calibration.reportedHostResolution), "ns");
+    result.addValue("Host timer resolution", "observed quantum", double(calibration.observedHostQuantum), "ns");
+    result.addValue("Host timer resolution", "smallest observed step", double(calibration.observedHostStep), "ns");
+    result.addValue("Profiling timer resolution", "reported", double(calibration.reportedProfilingResolution), "ns");
+    result.addValue("Profiling timer resolution", "observed quantum", double(calibration.observedProfilingQuantum), "ns");
+    result.addValue("Profiling timer resolution", "smallest observed step", double(calibration.observedProfilingStep), "ns");
+    result.addValue("Profiling timestamps outside device timer bracket", QString("%1 kernels").arg(profiledKernels), 100.0 * outsideBracket / profiledKernels, "%");
+
+    QStringList messages;
+    compareResolution("Profiling", calibration.observedProfilingQuantum, calibration.reportedProfilingResolution, messages);
+    compareResolution("Host timer", calibration.observedHostQuantum, calibration.reportedHostResolution, messages);
+    if (outsideBracket > 0) {
+        messages.append(QString("Profiling timestamps of %1 kernels were outside the device timer bracket (by up to %2 ns), device timer and profiling may not share a timebase").arg(outsideBracket).arg(maxBracketViolation));
+    }
+    result.message = messages.join("\n");
+    context.results.timerCalibration = calibration;
+    return true;
+}
@@ -0,0 +1,186 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+#include <cstring>
+
+struct TransferMethod
+{
+    QString name;
+    // Blocking transfer of the given number of bytes, either from host to device (upload) or from device to host
+    std::function<cl_int(size_t size, bool upload)> transfer;
+};
+
+bool TransferBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    size_t maxSize = size_t(64) * 1024 * 1024;
+    while ((maxSize > context.maxBufferSize()) && (maxSize > 1024 * 1024)) {
+        maxSize /= 2;
+    }
+    const size_t minSize = 4 * 1024;
+    std::vector<size_t> sizes;
+    for (size_t size = minSize; size <= maxSize; size *= 4) {
+        sizes.push_back(size);
+    }
+
+    // Pageable host memory
+    std::vector<char> hostData(maxSize, 1);
+    // Aligned host memory for CL_MEM_USE_HOST_PTR, implementations usually require page alignment for zero-copy
+    std::vector<char> useHostStorage(maxSize + 4096);
+    void* useHostPtr = useHostStorage.data();
+    size_t useHostSpace = useHostStorage.size();
+    std::align(4096, maxSize, useHostPtr, useHostSpace);
+
+    cl_mem deviceBuffer = context.createBuffer(CL_MEM_READ_WRITE, maxSize, nullptr, error);
+    cl_mem stagingBuffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, maxSize, nullptr, error);
+    cl_mem allocHostBuffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, maxSize, nullptr, error);
+    cl_mem useHostBuffer = context.createBuffer(CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, maxSize, useHostPtr, error);
+    if (!deviceBuffer || !stagingBuffer || !allocHostBuffer || !useHostBuffer) {
+        return false;
+    }
+
+    // CL_MEM_ALLOC_HOST_PTR memory stays mapped for the whole benchmark and is used as pinned staging memory for read/write
+    cl_int status = CL_SUCCESS;
+    void* pinnedPtr = _clEnqueueMapBuffer(context.queue, stagingBuffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, maxSize, 0, nullptr, nullptr, &status);
+    if (status != CL_SUCCESS) {
+        error = "Could not map staging buffer: " + utils::errorString(status);
+        return false;
+    }
+
+    // Invalidating the mapped region avoids a needless device to host copy, but is only available with OpenCL 1.2
+    const bool invalidateRegion = (context.device.clVersionMajor > 1) || (context.device.clVersionMinor >= 2);
+    const cl_map_flags writeMapFlags = invalidateRegion ? CL_MAP_WRITE_INVALIDATE_REGION : CL_MAP_WRITE;
+
+    auto mapTransfer = [&](cl_mem buffer, size_t size, bool upload, bool copy) -> cl_int {
+        cl_int mapStatus = CL_SUCCESS;
+        void* mapped = _clEnqueueMapBuffer(context.queue, buffer, CL_TRUE, upload ? writeMapFlags : CL_MAP_READ, 0, size, 0, nullptr, nullptr, &mapStatus);
+        if (mapStatus != CL_SUCCESS) {
+            return mapStatus;
+        }
+        if (copy) {
+            if (upload) {
+                memcpy(mapped, hostData.data(), size);
+            } else {
+                memcpy(hostData.data(), mapped, size);
+            }
+        }
+        mapStatus = _clEnqueueUnmapMemObject(context.queue, buffer, mapped, 0, nullptr, nullptr);
+        if (mapStatus != CL_SUCCESS) {
+            return mapStatus;
+        }
+        return _clFinish(context.queue);
+    };
+
+    // Check if mapping the CL_MEM_USE_HOST_PTR buffer returns the host allocation itself
+    void* mappedUseHostPtr = _clEnqueueMapBuffer(context.queue, useHostBuffer, CL_TRUE, CL_MAP_READ, 0, maxSize, 0, nullptr, nullptr, &status);
+    if (status != CL_SUCCESS) {
+        error = "Could not map host pointer buffer: " + utils::errorString(status);
+        _clEnqueueUnmapMemObject(context.queue, stagingBuffer, pinnedPtr, 0, nullptr, nullptr);
+        _clFinish(context.queue);
+        return false;
+    }
+    const bool useHostZeroCopy = (mappedUseHostPtr == useHostPtr);
+    _clEnqueueUnmapMemObject(context.queue, useHostBuffer, mappedUseHostPtr, 0, nullptr, nullptr);
+    _clFinish(context.queue);
+
+    std::vector<TransferMethod> methods;
+    methods.push_back({ "Read/Write", [&](size_t size, bool upload) {
+        return upload
+            ? _clEnqueueWriteBuffer(context.queue, deviceBuffer, CL_TRUE, 0, size, hostData.data(), 0, nullptr, nullptr)
+            : _clEnqueueReadBuffer(context.queue, deviceBuffer, CL_TRUE, 0, size, hostData.data(), 0, nullptr, nullptr);
+    } });
+    methods.push_back({ "Pinned Read/Write", [&](size_t size, bool upload) {
+        return upload
+            ? _clEnqueueWriteBuffer(context.queue, deviceBuffer, CL_TRUE, 0, size, pinnedPtr, 0, nullptr, nullptr)
+            : _clEnqueueReadBuffer(context.queue, deviceBuffer, CL_TRUE, 0, size, pinnedPtr, 0, nullptr, nullptr);
+    } });
+    methods.push_back({ "Map ALLOC_HOST_PTR", [&](size_t size, bool upload) {
+        return mapTransfer(allocHostBuffer, size, upload, true);
+    } });
+    methods.push_back({ useHostZeroCopy ? "Map USE_HOST_PTR (zero-copy)" : "Map USE_HOST_PTR", [&](size_t size, bool upload) {
+        return mapTransfer(useHostBuffer, size, upload, true);
+    } });
+
+    // On devices that share memory with the host the data can be accessed in place, so only the map and unmap remain
+    // No bytes are moved, so this is reported as latency and not compared against the throughput of the transfer methods
+    // CL_DEVICE_HOST_UNIFIED_MEMORY is deprecated since OpenCL 2.0, but still reported by most implementations
+    cl_bool unifiedMemory = context.deviceValue<cl_bool>(CL_DEVICE_HOST_UNIFIED_MEMORY);
+    if (context.device.extensionSupported("cl_nv_device_attribute_query")) {
+        unifiedMemory |= context.deviceValue<cl_bool>(CL_DEVICE_INTEGRATED_MEMORY_NV);
+    }
+
+    bool success = true;
+    for (bool upload : { true, false }) {
+        const QString direction = upload ? "Host to device" : "Device to host";
+        // Throughput per method (rows) and transfer size (columns)
+        std::vector<std::vector<double>> throughput(methods.size(), std::vector<double>(sizes.size(), 0.0));
+        for (size_t m = 0; (m < methods.size()) && success; m++) {
+            for (size_t s = 0; s < sizes.size(); s++) {
+                BenchmarkTimings timings;
+                const size_t size = sizes[s];
+                if (!context.timeHost([&]() { return methods[m].transfer(size, upload); }, timings, error)) {
+                    error = methods[m].name + ": " + error;
+                    success = false;
+                    break;
+                }
+                throughput[m][s] = (timings.median() > 0.0) ? size / timings.median() : 0.0;
+                result.addValue(direction + " " + methods[m].name, sizeString(size), throughput[m][s], "GB/s");
+                if (s == 0) {
+                    result.addValue(direction + " latency", methods[m].name + ", " + sizeString(size), timings.median() / 1000.0, "us");
+                }
+            }
+        }
+        if (!success) {
+            break;
+        }
+        // Transfer sizes at which another method becomes the fastest one
+        int fastestMethod = -1;
+        for (size_t s = 0; s < sizes.size(); s++) {
+            int fastest = 0;
+            for (size_t m = 1; m < methods.size(); m++) {
+                if (throughput[m][s] > throughput[fastest][s]) {
+                    fastest = int(m);
+                }
+            }
+            if (fastest != fastestMethod) {
+                result.addValue(direction + " crossover", methods[fastest].name + " fastest from", sizes[s] / 1024.0, "KiB");
+                fastestMethod = fastest;
+            }
+        }
+        if (unifiedMemory) {
+            for (size_t size : sizes) {
+                BenchmarkTimings timings;
+                if (!context.timeHost([&]() { return mapTransfer(allocHostBuffer, size, upload, false); }, timings, error)) {
+                    error = "Zero-copy map: " + error;
+                    success = false;
+                    break;
+                }
+                result.addValue(direction + " zero-copy map/unmap latency", sizeString(size), timings.median() / 1000.0, "us");
+            }
+        }
+        if (!success) {
+            break;
+        }
+    }
+
+    _clEnqueueUnmapMemObject(context.queue, stagingBuffer, pinnedPtr, 0, nullptr, nullptr);
+    _clFinish(context.queue);
+    return success;
+}
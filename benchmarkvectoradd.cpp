@@ -0,0 +1,90 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "benchmarks.h"
+
+static const char* vectorAddSource = R"(
+__kernel void vectorAdd(__global const float* a, __global const float* b, __global float* c)
+{
+    const size_t i = get_global_id(0);
+    c[i] = a[i] + b[i];
+}
+)";
+
+bool VectorAddBenchmark::run(BenchmarkContext& context, BenchmarkResult& result, QString& error)
+{
+    // 16 Mi elements (64 MiB per buffer), reduced for devices with less memory
+    size_t elementCount = size_t(1) << 24;
+    while ((elementCount * sizeof(cl_float) > context.maxBufferSize()) && (elementCount > 1024)) {
+        elementCount /= 2;
+    }
+    const size_t bufferSize = elementCount * sizeof(cl_float);
+
+    std::vector<cl_float> a(elementCount);
+    std::vector<cl_float> b(elementCount);
+    for (size_t i = 0; i < elementCount; i++) {
+        a[i] = cl_float(i % 1024);
+        b[i] = cl_float(2 * (i % 512));
+    }
+
+    cl_mem bufferA = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bufferSize, a.data(), error);
+    cl_mem bufferB = context.createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bufferSize, b.data(), error);
+    cl_mem bufferC = context.createBuffer(CL_MEM_WRITE_ONLY, bufferSize, nullptr, error);
+    if (!bufferA || !bufferB || !bufferC) {
+        return false;
+    }
+    cl_program program = context.buildProgram(vectorAddSource, "", error);
+    if (!program) {
+        return false;
+    }
+    cl_kernel kernel = context.createKernel(program, "vectorAdd", error);
+    if (!kernel) {
+        return false;
+    }
+    _clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufferA);
+    _clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufferB);
+    _clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufferC);
+
+    BenchmarkTimings timings;
+    if (!context.timeKernel(kernel, 1, &elementCount, nullptr, timings, error)) {
+        return false;
+    }
+
+    std::vector<cl_float> c(elementCount);
+    cl_int status = _clEnqueueReadBuffer(context.queue, bufferC, CL_TRUE, 0, bufferSize, c.data(), 0, nullptr, nullptr);
+    if (status != CL_SUCCESS) {
+        error = "Could not read result buffer: " + utils::errorString(status);
+        return false;
+    }
+    for (size_t i = 0; i < elementCount; i++) {
+        if (c[i] != a[i] + b[i]) {
+            error = QString("Validation failed at element %1: expected %2, got %3").arg(i).arg(a[i] + b[i]).arg(c[i]);
+            return false;
+        }
+    }
+
+    // Two reads and one write per element
+    const double bytes = 3.0 * bufferSize;
+    result.addValue("Elements", double(elementCount), "");
+    result.addValue("Kernel time", "median", timings.median() / 1000.0, "us");
+    result.addValue("Kernel time", "min", timings.min() / 1000.0, "us");
+    result.addValue("Bandwidth", "median", bytes / timings.median(), "GB/s");
+    return true;
+}
@@ -19,10 +19,12 @@
 */
 
 #include "database.h"
+#include <array>
 
 QString Database::username = "";
 QString Database::password = "";
 QString Database::databaseUrl = "http://opencl.gpuinfo.org/";
+ContentEncoding Database::contentEncoding = ContentEncoding::identity;
 
 Database database;
 
@@ -60,22 +62,125 @@ QString Database::get(QString url)
 	}
 }
 
-bool Database::getReportId(QJsonObject json, int& id)
+// Standard CRC-32 (IEEE 802.3) as required by the gzip trailer
+static quint32 crc32(const QByteArray& data)
 {
-	manager = new QNetworkAccessManager(nullptr);
+	static const std::array<quint32, 256> table = [] {
+		std::array<quint32, 256> values{};
+		for (quint32 i = 0; i < 256; i++) {
+			quint32 c = i;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			}
+			values[i] = c;
+		}
+		return values;
+	}();
+	quint32 crc = 0xFFFFFFFFu;
+	for (const char byte : data) {
+		crc = table[(crc ^ static_cast<quint8>(byte)) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFFu;
+}
+
+QByteArray Database::encodePayload(const QByteArray& payload, ContentEncoding encoding)
+{
+	if (encoding == ContentEncoding::identity) {
+		return payload;
+	}
+	// qCompress returns a four byte (big endian) uncompressed size followed by a zlib stream
+	QByteArray compressed = qCompress(payload, 9);
+	if (encoding == ContentEncoding::deflate) {
+		// "deflate" content coding is the plain zlib stream (RFC 1950)
+		return compressed.mid(4);
+	}
+	// gzip (RFC 1952) wraps the raw deflate data, so strip the two byte zlib header and the four byte adler32 trailer
+	QByteArray gzip;
+	gzip.reserve(compressed.size() + 12);
+	static const char header[10] = { '\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff' };
+	gzip.append(header, sizeof(header));
+	gzip.append(compressed.constData() + 6, compressed.size() - 10);
+	const quint32 crc = crc32(payload);
+	const quint32 size = static_cast<quint32>(payload.size());
+	for (int i = 0; i < 4; i++) {
+		gzip.append(static_cast<char>((crc >> (i * 8)) & 0xFF));
+	}
+	for (int i = 0; i < 4; i++) {
+		gzip.append(static_cast<char>((size >> (i * 8)) & 0xFF));
+	}
+	return gzip;
+}
+
+QHttpMultiPart* Database::createReportMultiPart(QString fileName, QJsonObject& json)
+{
+	// The server parses the json, so there is no need to send the (much larger) indented form
+	const QByteArray document = QJsonDocument(json).toJson(QJsonDocument::Compact);
+	const QByteArray payload = encodePayload(document, contentEncoding);
+	qInfo() << "Report payload is" << payload.size() << "bytes (" << document.size() << "bytes uncompressed )";
 	QHttpMultiPart* multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+	// Multipart parsers ignore content codings of single parts (RFC 7578), so the coding of the data part is sent as a separate form field
+	// that the server reads before decoding the uploaded file (see docs/maintenance/upload_compression.md)
+	if (contentEncoding != ContentEncoding::identity) {
+		QHttpPart encodingPart;
+		encodingPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"encoding\""));
+		encodingPart.setBody((contentEncoding == ContentEncoding::gzip) ? "gzip" : "deflate");
+		multiPart->append(encodingPart);
+	}
 	QHttpPart httpPart;
-	httpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"data\"; filename=\"update_check_report.json\""));
-	QJsonDocument doc(json);
-	httpPart.setBody(doc.toJson());
+	switch (contentEncoding) {
+	case ContentEncoding::gzip:
+		httpPart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/gzip"));
+		break;
+	case ContentEncoding::deflate:
+		httpPart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/zlib"));
+		break;
+	default:
+		break;
+	}
+	httpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"data\"; filename=\"" + fileName + "\""));
+	// Stream the body from a buffer that shares the payload instead of copying it into the part
+	QBuffer* bodyDevice = new QBuffer(multiPart);
+	bodyDevice->setData(payload);
+	bodyDevice->open(QIODevice::ReadOnly);
+	httpPart.setBodyDevice(bodyDevice);
 	multiPart->append(httpPart);
-	QUrl qurl(databaseUrl + "api/v1/getreportid.php");
+	return multiPart;
+}
+
+QNetworkReply* Database::postReport(QString endpoint, QString fileName, QJsonObject& json)
+{
+	QHttpMultiPart* multiPart = createReportMultiPart(fileName, json);
+	QUrl qurl(databaseUrl + endpoint);
 	QNetworkRequest request(qurl);
+	QElapsedTimer timer;
+	timer.start();
 	QNetworkReply* reply = manager->post(request, multiPart);
 	multiPart->setParent(reply);
 	QEventLoop loop;
 	connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
 	loop.exec(QEventLoop::ExcludeUserInputEvents);
+	qInfo() << "Posted report to" << endpoint << "in" << timer.elapsed() << "ms";
+	return reply;
+}
+
+ReportState Database::reportStateFromReply(const QString& message)
+{
+	if (message == "report_present") {
+		return ReportState::is_present;
+	}
+	if (message == "report_not_present") {
+		return ReportState::not_present;
+	}
+	if (message == "report_updatable") {
+		return ReportState::is_updatable;
+	}
+	return ReportState::unknown;
+}
+
+bool Database::getReportId(QJsonObject json, int& id)
+{
+	manager = new QNetworkAccessManager(nullptr);
+	QNetworkReply* reply = postReport("api/v1/getreportid.php", "update_check_report.json", json);
 	bool result = false;
 	if (reply->error() == QNetworkReply::NoError)
 	{
@@ -93,33 +198,13 @@ bool Database::getReportId(QJsonObject json, int& id)
 bool Database::getReportState(QJsonObject json, ReportState& state)
 {
 	manager = new QNetworkAccessManager(nullptr);
-	QHttpMultiPart* multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
-	QHttpPart httpPart;
-	httpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"data\"; filename=\"update_check_report.json\""));
-	QJsonDocument doc(json);
-	httpPart.setBody(doc.toJson());
-	multiPart->append(httpPart);
-	QUrl qurl(databaseUrl + "api/v1/getreportstate.php");
-	QNetworkRequest request(qurl);
-	QNetworkReply* reply = manager->post(request, multiPart);
-	multiPart->setParent(reply);
-	QEventLoop loop;
-	connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-	loop.exec(QEventLoop::ExcludeUserInputEvents);
+	QNetworkReply* reply = postReport("api/v1/getreportstate.php", "update_check_report.json", json);
 	bool result = false;
 	state = ReportState::unknown;
 	if (reply->error() == QNetworkReply::NoError)
 	{
 		QString message = reply->readAll();
-		if (message == "report_present") {
-			state = ReportState::is_present;
-		}
-		if (message == "report_not_present") {
-			state = ReportState::not_present;
-		}
-		if (message == "report_updatable") {
-			state = ReportState::is_updatable;
-		}
+		state = reportStateFromReply(message);
 		result = true;
     } else {
         QString message = reply->errorString();
@@ -134,19 +219,7 @@ bool Database::getReportState(QJsonObject json, ReportState& state)
 bool Database::uploadReport(QJsonObject json, QString &message)
 {
 	manager = new QNetworkAccessManager(nullptr);
-	QHttpMultiPart* multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
-	QHttpPart httpPart;
-	httpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"data\"; filename=\"openclreport.json\""));
-	QJsonDocument doc(json);
-	httpPart.setBody(doc.toJson());
-	multiPart->append(httpPart);
-	QUrl qurl(databaseUrl + "api/v1/uploadreport.php");
-	QNetworkRequest request(qurl);
-	QNetworkReply* reply = manager->post(request, multiPart);
-	multiPart->setParent(reply);
-	QEventLoop loop;
-	connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-	loop.exec(QEventLoop::ExcludeUserInputEvents);
+	QNetworkReply* reply = postReport("api/v1/uploadreport.php", "openclreport.json", json);
 	bool result = false;
 	if (reply->error() == QNetworkReply::NoError)
 	{
@@ -169,5 +242,91 @@ bool Database::checkServerConnection(QString& message)
 	connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
 	loop.exec(QEventLoop::ExcludeUserInputEvents);
 	message = reply->errorString();
+	negotiateContentEncoding(reply);
 	return (reply->error() == QNetworkReply::NoError);
 }
+
+void Database::negotiateContentEncoding(QNetworkReply* reply)
+{
+	// Reports are only compressed if the server explicitly states that it decodes the uploaded data part
+	// A plain Accept-Encoding header is not enough, as it applies to whole request bodies and not to single multipart parts
+	contentEncoding = ContentEncoding::identity;
+	const QList<QByteArray> acceptedEncodings = reply->rawHeader("X-Report-Content-Encoding").toLower().split(',');
+	for (const QByteArray& encoding : acceptedEncodings) {
+		const QByteArray coding = encoding.split(';').first().trimmed();
+		if (coding == "gzip") {
+			contentEncoding = ContentEncoding::gzip;
+			break;
+		}
+		if (coding == "deflate") {
+			contentEncoding = ContentEncoding::deflate;
+		}
+	}
+}
+
+void Database::cancelReportStateRequests()
+{
+	for (QNetworkReply* reply : pendingReplies) {
+		reply->disconnect(this);
+		reply->abort();
+		reply->deleteLater();
+	}
+	pendingReplies.clear();
+}
+
+void Database::requestReportStates(const QList<QJsonObject>& reports)
+{
+	// Replies for a previous request are no longer of interest (e.g. after an upload or a settings change)
+	cancelReportStateRequests();
+	if (!asyncManager) {
+		asyncManager = new QNetworkAccessManager(this);
+	}
+	QUrl qurl(databaseUrl + "api/v1/serverstate.php");
+	setCredentials(qurl);
+	QNetworkReply* serverReply = asyncManager->get(QNetworkRequest(qurl));
+	pendingReplies.append(serverReply);
+	connect(serverReply, &QNetworkReply::finished, this, [this, serverReply, reports]() {
+		pendingReplies.removeOne(serverReply);
+		serverReply->deleteLater();
+		if (serverReply->error() != QNetworkReply::NoError) {
+			qInfo() << "Unable to reach server";
+			emit serverUnreachable(serverReply->errorString());
+			return;
+		}
+		negotiateContentEncoding(serverReply);
+		// All state requests are issued at once, the network access manager runs them concurrently
+		for (int i = 0; i < reports.size(); i++) {
+			QJsonObject json = reports[i];
+			QHttpMultiPart* multiPart = createReportMultiPart("update_check_report.json", json);
+			QNetworkReply* reply = asyncManager->post(QNetworkRequest(QUrl(databaseUrl + "api/v1/getreportstate.php")), multiPart);
+			multiPart->setParent(reply);
+			pendingReplies.append(reply);
+			connect(reply, &QNetworkReply::finished, this, [this, reply, i]() {
+				pendingReplies.removeOne(reply);
+				reply->deleteLater();
+				ReportState state = ReportState::unknown;
+				if (reply->error() == QNetworkReply::NoError) {
+					state = reportStateFromReply(reply->readAll());
+				} else {
+					qWarning() << "Could not get report state:" << reply->errorString();
+				}
+				emit reportStateReceived(i, state);
+			});
+		}
+	});
+}
+
+// Content hashes (see Report::contentHash) of reports the database has confirmed to be present
+// are stored locally, so state lookups for identical reports can be skipped
+
+bool Database::isSubmissionConfirmed(const QString& hash)
+{
+	QSettings settings("saschawillems", "openclcapsviewer");
+	return settings.value("submissions/" + hash, false).toBool();
+}
+
+void Database::confirmSubmission(const QString& hash)
+{
+	QSettings settings("saschawillems", "openclcapsviewer");
+	settings.setValue("submissions/" + hash, true);
+}
@@ -24,9 +24,12 @@
 #include <QUrl>
 #include <QEventLoop>
 #include <QHttpMultiPart>
+#include <QBuffer>
+#include <QElapsedTimer>
 #include <QXmlStreamReader>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QSettings>
 #ifdef GUI_BUILD
 #include <QMessageBox>
 #endif
@@ -34,6 +37,8 @@
 #pragma once
 
 enum class ReportState { unknown, not_present, is_present, is_updatable };
+// Content encodings that can be applied to report payloads, only used if the server advertises them in the X-Report-Content-Encoding header of serverstate.php
+enum class ContentEncoding { identity, deflate, gzip };
 
 class Database : public QObject
 {
@@ -41,16 +46,33 @@ class Database : public QObject
 private:
 	QNetworkProxy* proxy;
 	QNetworkAccessManager* manager;
+	// Used for non-blocking requests, which may outlive a single call
+	QNetworkAccessManager* asyncManager = nullptr;
+	QList<QNetworkReply*> pendingReplies;
 	void setCredentials(QUrl& url);
 	QString get(QString url);
+	QByteArray encodePayload(const QByteArray& payload, ContentEncoding encoding);
+	void negotiateContentEncoding(QNetworkReply* reply);
+	ReportState reportStateFromReply(const QString& message);
+	QHttpMultiPart* createReportMultiPart(QString fileName, QJsonObject& json);
+	QNetworkReply* postReport(QString endpoint, QString fileName, QJsonObject& json);
 public:
 	static QString username;
 	static QString password;
 	static QString databaseUrl;
+	static ContentEncoding contentEncoding;
 	bool getReportId(QJsonObject json, int& id);
 	bool getReportState(QJsonObject json, ReportState& state);
 	bool uploadReport(QJsonObject json, QString& message);
 	bool checkServerConnection(QString& message);
+	void requestReportStates(const QList<QJsonObject>& reports);
+	bool isSubmissionConfirmed(const QString& hash);
+	void confirmSubmission(const QString& hash);
+	void cancelReportStateRequests();
+Q_SIGNALS:
+	// Emitted for every report passed to requestReportStates, index refers to the position in that list
+	void reportStateReceived(int index, ReportState state);
+	void serverUnreachable(QString message);
 };
 
 extern Database database;
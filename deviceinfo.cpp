@@ -749,9 +749,10 @@ void DeviceInfo::readExtensionInfo()
 		}
 	}
 
-	if (extensionSupported("cl_khr_command_buffer ")) {
+	if (extensionSupported("cl_khr_command_buffer")) {
 		std::vector<DeviceInfoValueDescriptor> infoList = {
 			{ CL_DEVICE_COMMAND_BUFFER_CAPABILITIES_KHR, clValueType::cl_device_command_buffer_capabilities_khr, utils::displayCommandBufferCapabilities },
+			{ CL_DEVICE_COMMAND_BUFFER_REQUIRED_QUEUE_PROPERTIES_KHR, clValueType::cl_command_queue_properties, utils::displayCommandQueueProperties },
 		};
 		for (auto &info : infoList) {
 			readDeviceInfoValue(info, "cl_khr_command_buffer");
@@ -964,8 +965,11 @@ QJsonObject DeviceInfo::toJson()
 	QJsonObject jsonRoot;
 
 	// Extensions
+	// Sorted by name, so the same device always results in the same report
+	std::vector<DeviceExtension> sortedExtensions = extensions;
+	std::sort(sortedExtensions.begin(), sortedExtensions.end(), [](const DeviceExtension& a, const DeviceExtension& b) { return a.name < b.name; });
 	QJsonArray jsonExtensions;
-	for (auto& ext : extensions)
+	for (auto& ext : sortedExtensions)
 	{
 		QJsonObject jsonNode;
 		jsonNode["name"] = ext.name;
@@ -1013,22 +1017,29 @@ QJsonObject DeviceInfo::toJson()
 	jsonRoot["info"] = jsonDeviceInfos;
 
 	// Supported image formats
-	QJsonArray jsonImages;
-	for (auto& imageType : imageTypes) 
+	// The formats are stored in unordered maps, so they're sorted to get a stable order
+	std::vector<std::tuple<cl_mem_object_type, cl_channel_order, cl_channel_type, cl_mem_flags>> imageFormats;
+	for (auto& imageType : imageTypes)
 	{
-		for (auto& channelOrder : imageType.second.channelOrders) 
+		for (auto& channelOrder : imageType.second.channelOrders)
 		{
-			for (auto& channelType : channelOrder.second.channelTypes) 
+			for (auto& channelType : channelOrder.second.channelTypes)
 			{
-				QJsonObject jsonNode;
-				jsonNode["type"] = QJsonValue(int(imageType.first));
-				jsonNode["channelorder"] = QJsonValue(int(channelOrder.first));
-				jsonNode["channeltype"] = QJsonValue(int(channelType.first));
-				jsonNode["flags"] = QJsonValue(int(channelType.second.memFlags));
-				jsonImages.append(jsonNode);
+				imageFormats.push_back({ imageType.first, channelOrder.first, channelType.first, channelType.second.memFlags });
 			}
 		}
 	}
+	std::sort(imageFormats.begin(), imageFormats.end());
+	QJsonArray jsonImages;
+	for (auto& imageFormat : imageFormats)
+	{
+		QJsonObject jsonNode;
+		jsonNode["type"] = QJsonValue(int(std::get<0>(imageFormat)));
+		jsonNode["channelorder"] = QJsonValue(int(std::get<1>(imageFormat)));
+		jsonNode["channeltype"] = QJsonValue(int(std::get<2>(imageFormat)));
+		jsonNode["flags"] = QJsonValue(int(std::get<3>(imageFormat)));
+		jsonImages.append(jsonNode);
+	}
 	jsonRoot["imageformats"] = jsonImages;
 
 	// Additional OpenCL info
@@ -1040,6 +1051,46 @@ QJsonObject DeviceInfo::toJson()
 	return jsonRoot;
 }
 
+QJsonArray DeviceInfo::benchmarksToJson()
+{
+	QJsonArray jsonBenchmarks;
+	for (auto& result : benchmarkResults)
+	{
+		QJsonObject jsonNode;
+		jsonNode["name"] = result.name;
+		if (!result.message.isEmpty()) {
+			jsonNode["message"] = result.message;
+		}
+		QJsonArray jsonValues;
+		for (auto& value : result.values)
+		{
+			QJsonObject jsonValue;
+			jsonValue["name"] = value.name;
+			if (value.detail.isEmpty()) {
+				jsonValue["detail"] = QJsonValue::Null;
+			} else {
+				jsonValue["detail"] = value.detail;
+			}
+			jsonValue["value"] = value.value;
+			jsonValue["unit"] = value.unit;
+			jsonValues.append(jsonValue);
+		}
+		jsonNode["values"] = jsonValues;
+		jsonBenchmarks.append(jsonNode);
+	}
+	return jsonBenchmarks;
+}
+
+QJsonArray DeviceInfo::partitionsToJson()
+{
+	QJsonArray jsonPartitions;
+	for (auto& partition : partitions)
+	{
+		jsonPartitions.append(partition.toJson());
+	}
+	return jsonPartitions;
+}
+
 void DeviceInfo::readExtensions()
 {
 	extensions.clear();
@@ -1146,3 +1197,75 @@ QString DeviceInfoValueDetailValue::getDisplayValue()
 		return value.toString();
 	}
 }
+
+BenchmarkValue::BenchmarkValue(QString name, QString detail, double value, QString unit)
+{
+	this->name = name;
+	this->detail = detail;
+	this->value = value;
+	this->unit = unit;
+}
+
+QString BenchmarkValue::getDisplayValue()
+{
+	// Keep roughly four significant digits without switching to scientific notation
+	const double magnitude = std::abs(value);
+	const int decimals = (magnitude >= 1000.0) ? 0 : (magnitude >= 100.0) ? 1 : (magnitude >= 10.0) ? 2 : 3;
+	return QString::number(value, 'f', decimals) + " " + unit;
+}
+
+void BenchmarkResult::addValue(QString name, double value, QString unit)
+{
+	values.push_back(BenchmarkValue(name, "", value, unit));
+}
+
+void BenchmarkResult::addValue(QString name, QString detail, double value, QString unit)
+{
+	values.push_back(BenchmarkValue(name, detail, value, unit));
+}
+
+QJsonObject DevicePartition::toJson()
+{
+	QJsonObject jsonNode;
+	jsonNode["scheme"] = scheme;
+	QJsonArray jsonProperties;
+	for (auto property : properties)
+	{
+		jsonProperties.append(qint64(property));
+	}
+	jsonNode["properties"] = jsonProperties;
+	if (!error.isEmpty()) {
+		jsonNode["error"] = error;
+	}
+	QJsonArray jsonSubDevices;
+	for (auto& subDevice : subDevices)
+	{
+		jsonSubDevices.append(subDevice.toJson());
+	}
+	jsonNode["subdevices"] = jsonSubDevices;
+	return jsonNode;
+}
+
+QJsonObject SubDeviceInfo::toJson()
+{
+	QJsonObject jsonNode;
+	jsonNode["computeunits"] = qint64(computeUnits);
+	jsonNode["globalmemsize"] = qint64(globalMemSize);
+	jsonNode["globalmemcachesize"] = qint64(globalMemCacheSize);
+	jsonNode["maxworkgroupsize"] = qint64(maxWorkGroupSize);
+	jsonNode["partitionmaxsubdevices"] = qint64(partitionMaxSubDevices);
+	QJsonArray jsonProperties;
+	for (auto property : partitionProperties)
+	{
+		jsonProperties.append(qint64(property));
+	}
+	jsonNode["partitionproperties"] = jsonProperties;
+	jsonNode["partitionaffinitydomain"] = qint64(partitionAffinityDomain);
+	QJsonArray jsonPartitions;
+	for (auto& partition : partitions)
+	{
+		jsonPartitions.append(partition.toJson());
+	}
+	jsonNode["partitions"] = jsonPartitions;
+	return jsonNode;
+}
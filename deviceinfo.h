@@ -27,11 +27,16 @@
 #include "displayutils.h"
 #include "platforminfo.h"
 #include "openclfunctions.h"
+#include "roofline.h"
+#include "timercalibration.h"
 #include <unordered_map>
 #include <string>
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
+#include <tuple>
+#include <cmath>
 #include <QVariantMap>
 #include <QDebug>
 #include <QJsonDocument>
@@ -101,6 +106,53 @@ struct DeviceImageTypeInfo
     std::unordered_map<cl_channel_order, DeviceImageChannelOrderInfo> channelOrders;
 };
 
+// Single measured value of a benchmark, e.g. the bandwidth of one kernel variant
+struct BenchmarkValue
+{
+    QString name;
+    QString detail;
+    double value;
+    QString unit;
+    BenchmarkValue(QString name, QString detail, double value, QString unit);
+    QString getDisplayValue();
+};
+
+// Measured values of a single benchmark, the message is set if the benchmark was skipped or failed
+struct BenchmarkResult
+{
+    QString name;
+    QString message;
+    std::vector<BenchmarkValue> values;
+    void addValue(QString name, double value, QString unit);
+    void addValue(QString name, QString detail, double value, QString unit);
+};
+
+struct SubDeviceInfo;
+
+// Result of partitioning a device with one scheme (e.g. equally or by affinity domain), the error is set if the partitioning failed
+struct DevicePartition
+{
+    QString scheme;
+    std::vector<cl_device_partition_property> properties;
+    QString error;
+    std::vector<SubDeviceInfo> subDevices;
+    QJsonObject toJson();
+};
+
+// Sub-device created from a partition, with the partitions it supports itself
+struct SubDeviceInfo
+{
+    cl_uint computeUnits = 0;
+    cl_ulong globalMemSize = 0;
+    cl_ulong globalMemCacheSize = 0;
+    size_t maxWorkGroupSize = 0;
+    cl_uint partitionMaxSubDevices = 0;
+    std::vector<cl_device_partition_property> partitionProperties;
+    cl_device_affinity_domain partitionAffinityDomain = 0;
+    std::vector<DevicePartition> partitions;
+    QJsonObject toJson();
+};
+
 // Contains values to uniquely identify the device when talking to the database
 struct DeviceIdentifier
 {
@@ -114,7 +166,6 @@ class DeviceInfo
 {
 private:
     QString getDeviceInfoString(cl_device_info info);
-    bool extensionSupported(const char* name);
     void readDeviceInfoValue(DeviceInfoValueDescriptor descriptor, QString extension = "");
     void readDeviceIdentifier();
     void readDeviceInfo();
@@ -132,8 +183,19 @@ public:
     std::vector<DeviceInfoValue> deviceInfo;
     std::vector<DeviceExtension> extensions;
     std::unordered_map<cl_mem_object_type, DeviceImageTypeInfo> imageTypes;
+    // Only filled if benchmarks have been run for this device
+    std::vector<BenchmarkResult> benchmarkResults;
+    // Only filled if the partition benchmark has been run for this device
+    std::vector<DevicePartition> partitions;
+    // Only filled if the roofline benchmark has been run for this device
+    RooflineModel roofline;
+    // Only filled if the timer calibration benchmark has been run for this device
+    TimerCalibration timerCalibration;
+    bool extensionSupported(const char* name);
     void read();
     QJsonObject toJson();
+    QJsonArray benchmarksToJson();
+    QJsonArray partitionsToJson();
 };
 
 #endif // DEVICEINFO_H
@@ -30,6 +30,9 @@
 #include "openclfunctions.h"
 #include "operatingsystem.h"
 #include "report.h"
+#include "reportstore.h"
+#include "benchmark.h"
+#include "autotuner.h"
 #include "settings.h"
 #include <stdio.h>
 #include <iostream>
@@ -104,6 +107,20 @@ int main(int argc, char *argv[])
     QCommandLineOption optionListDevices("devices", "List available devices");
     QCommandLineOption optionUploadReportSubmitter("submitter", "Set optional submitter name for report upload", "submitter", "");
     QCommandLineOption optionUploadReportComment("comment", "Set optional comment for report upload", "comment", "");
+    QCommandLineOption optionIngestReports("ingest", "Ingest all reports from the given directory into the local report store", "directory", "");
+    QCommandLineOption optionQueryReports("query", "Run a filter or aggregate query against the local report store", "expression", "");
+    QCommandLineOption optionGenerateReports("generate-reports", "Fill the local report store with the given number of synthetic reports (for benchmarking queries)", "count", "");
+    QCommandLineOption optionReportStore("store", "Set directory of the local report store", "store", "reportstore");
+    QCommandLineOption optionSimilarTo("similar-to", "List reports from the local report store with the most similar extension sets", "report", "");
+    QCommandLineOption optionSimilarCount("top", "Set number of reports listed by similar-to", "count", "10");
+    QCommandLineOption optionCluster("cluster", "Cluster reports of the local report store by extension similarity (0..1)", "threshold", "");
+    QCommandLineOption optionBenchmark("bench", "Run benchmarks for the device selected with deviceindex and print the results (combine with save to store the results in the report)");
+    QCommandLineOption optionBenchmarkSelection("benchmarks", "Set comma separated list of benchmarks to run", "benchmarks", "");
+    QCommandLineOption optionBenchmarkIterations("iterations", "Set number of measured iterations per benchmark", "iterations", "10");
+    QCommandLineOption optionTune("tune", "Tune work group and tile sizes of a kernel for the device with given index and store the best configuration in the tuning database", "space", "");
+    QCommandLineOption optionTuningExport("tune-export", "Export the tuning database to the given file", "file", "");
+    QCommandLineOption optionRooflineExport("roofline-export", "Export the roofline measured by the roofline benchmark to the given JSON or CSV file (combine with bench)", "file", "");
+    QCommandLineOption optionTimerExport("timer-export", "Export the calibration measured by the timers benchmark to the given JSON or CSV file (combine with bench)", "file", "");
 
     parser.setApplicationDescription("OpenCL Hardware Capability Viewer");
     parser.addHelpOption();
@@ -116,6 +133,20 @@ int main(int argc, char *argv[])
     parser.addOption(optionUploadReportSubmitter);
     parser.addOption(optionUploadReportComment);
     parser.addOption(optionListDevices);
+    parser.addOption(optionIngestReports);
+    parser.addOption(optionQueryReports);
+    parser.addOption(optionGenerateReports);
+    parser.addOption(optionReportStore);
+    parser.addOption(optionSimilarTo);
+    parser.addOption(optionSimilarCount);
+    parser.addOption(optionCluster);
+    parser.addOption(optionBenchmark);
+    parser.addOption(optionBenchmarkSelection);
+    parser.addOption(optionBenchmarkIterations);
+    parser.addOption(optionTune);
+    parser.addOption(optionTuningExport);
+    parser.addOption(optionRooflineExport);
+    parser.addOption(optionTimerExport);
     parser.process(application);
     if (parser.isSet(optionLogFile)) {
         qInstallMessageHandler(logMessageHandler);
@@ -126,6 +157,65 @@ int main(int argc, char *argv[])
         settings.proxyEnabled = false;
         settings.applyProxySettings();
     }
+
+    // Report store operations work on saved reports and don't require OpenCL
+    if (parser.isSet(optionIngestReports) || parser.isSet(optionGenerateReports) || parser.isSet(optionQueryReports) || parser.isSet(optionSimilarTo) || parser.isSet(optionCluster))
+    {
+        ReportStore reportStore(parser.value(optionReportStore));
+        QString error;
+        if (parser.isSet(optionIngestReports) && !reportStore.ingest(parser.value(optionIngestReports), error)) {
+            std::cerr << error.toStdString() << "\n";
+            return EXIT_FAILURE;
+        }
+        if (parser.isSet(optionGenerateReports)) {
+            const qint64 count = parser.value(optionGenerateReports).toLongLong();
+            if (count <= 0) {
+                std::cerr << "Number of synthetic reports needs to be greater than zero\n";
+                return EXIT_FAILURE;
+            }
+            if (!reportStore.generate(count, error)) {
+                std::cerr << error.toStdString() << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        if ((parser.isSet(optionIngestReports) || parser.isSet(optionGenerateReports)) && !parser.isSet(optionQueryReports) && !parser.isSet(optionSimilarTo) && !parser.isSet(optionCluster)) {
+            return 0;
+        }
+        if (!reportStore.open(error)) {
+            std::cerr << error.toStdString() << "\n";
+            return EXIT_FAILURE;
+        }
+        QString result;
+        bool success = true;
+        if (parser.isSet(optionQueryReports)) {
+            success = reportStore.query(parser.value(optionQueryReports), result, error);
+        }
+        if (success && parser.isSet(optionSimilarTo)) {
+            success = reportStore.similarTo(parser.value(optionSimilarTo), parser.value(optionSimilarCount).toInt(), result, error);
+        }
+        if (success && parser.isSet(optionCluster)) {
+            success = reportStore.cluster(parser.value(optionCluster).toDouble(), result, error);
+        }
+        std::cout << result.toStdString();
+        if (!success) {
+            std::cerr << error.toStdString() << "\n";
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+
+    // Exporting tuning results doesn't require OpenCL either
+    if (parser.isSet(optionTuningExport))
+    {
+        TuningDatabase tuningDatabase;
+        QString error;
+        if (!tuningDatabase.exportTo(parser.value(optionTuningExport), error)) {
+            std::cerr << error.toStdString() << "\n";
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+
 #ifdef GUI_BUILD
     MainWindow w;
 #endif
@@ -156,6 +246,90 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    if (parser.isSet(optionTune))
+    {
+        int deviceIndex = 0;
+        if (parser.isSet(optionUploadReportDeviceIndex)) {
+            deviceIndex = parser.value(optionUploadReportDeviceIndex).toInt();
+        }
+        if ((deviceIndex < 0) || (deviceIndex >= int(devices.size()))) {
+            std::cerr << "Device index out of range\n";
+            return EXIT_FAILURE;
+        }
+        BenchmarkSettings tuningSettings;
+        tuningSettings.iterations = std::max(1, parser.value(optionBenchmarkIterations).toInt());
+        Autotuner autotuner(devices[deviceIndex], tuningSettings);
+        QString result;
+        if (!autotuner.tune(parser.value(optionTune), result, error)) {
+            std::cerr << error.toStdString() << "\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << result.toStdString();
+        return 0;
+    }
+
+    if (parser.isSet(optionBenchmark))
+    {
+        int deviceIndex = 0;
+        if (parser.isSet(optionUploadReportDeviceIndex)) {
+            deviceIndex = parser.value(optionUploadReportDeviceIndex).toInt();
+        }
+        if ((deviceIndex < 0) || (deviceIndex >= int(devices.size()))) {
+            std::cerr << "Device index out of range\n";
+            return EXIT_FAILURE;
+        }
+        BenchmarkSettings benchmarkSettings;
+        benchmarkSettings.iterations = std::max(1, parser.value(optionBenchmarkIterations).toInt());
+        QStringList selection;
+        if (parser.isSet(optionBenchmarkSelection)) {
+            selection = parser.value(optionBenchmarkSelection).split(",", Qt::SkipEmptyParts);
+        }
+        BenchmarkRunner benchmarkRunner;
+        DeviceInfo& device = devices[deviceIndex];
+        const BenchmarkRunResults results = benchmarkRunner.run(device, selection, benchmarkSettings);
+        device.benchmarkResults = results.benchmarks;
+        device.partitions = results.partitions;
+        device.roofline = results.roofline;
+        device.timerCalibration = results.timerCalibration;
+        std::cout << device.identifier.name.toStdString() << "\n";
+        for (auto& result : device.benchmarkResults) {
+            std::cout << result.name.toStdString() << "\n";
+            if (!result.message.isEmpty()) {
+                std::cout << "    " << result.message.toStdString() << "\n";
+            }
+            for (auto& value : result.values) {
+                QString caption = value.name;
+                if (!value.detail.isEmpty()) {
+                    caption += " (" + value.detail + ")";
+                }
+                std::cout << "    " << caption.toStdString() << ": " << value.getDisplayValue().toStdString() << "\n";
+            }
+        }
+        if (parser.isSet(optionRooflineExport)) {
+            if (!device.roofline.valid()) {
+                std::cerr << "No roofline has been measured, add roofline to the selected benchmarks\n";
+                return EXIT_FAILURE;
+            }
+            if (!device.roofline.exportTo(parser.value(optionRooflineExport), error)) {
+                std::cerr << error.toStdString() << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        if (parser.isSet(optionTimerExport)) {
+            if (!device.timerCalibration.valid()) {
+                std::cerr << "No timer calibration has been measured, add timers to the selected benchmarks\n";
+                return EXIT_FAILURE;
+            }
+            if (!device.timerCalibration.exportTo(parser.value(optionTimerExport), error)) {
+                std::cerr << error.toStdString() << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        if (!parser.isSet(optionSaveReport)) {
+            return 0;
+        }
+    }
+
     if (parser.isSet(optionSaveReport))
     {
         int deviceIndex = 0;
@@ -58,6 +58,8 @@ MainWindow::MainWindow(QWidget *parent)
     connectFilterAndModel(models.platformInfo, filterProxies.platformInfo);
     connect(ui->filterLineEditPlatformInfo, SIGNAL(textChanged(QString)), this, SLOT(slotFilterPlatformInfo(QString)));
 
+    ui->treeViewBenchmarks->setModel(&models.benchmarks);
+
     // Slots
     connect(ui->comboBoxDevice, SIGNAL(currentIndexChanged(int)), this, SLOT(slotComboBoxDeviceChanged(int)));
     connect(ui->toolButtonSave, SIGNAL(pressed()), this, SLOT(slotSaveReport()));
@@ -67,6 +69,11 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->toolButtonAbout, SIGNAL(pressed()), this, SLOT(slotAbout()));
     connect(ui->toolButtonSettings, SIGNAL(pressed()), this, SLOT(slotSettings()));
     connect(ui->toolButtonExit, SIGNAL(pressed()), this, SLOT(slotClose()));
+    connect(&database, SIGNAL(reportStateReceived(int,ReportState)), this, SLOT(slotReportStateReceived(int,ReportState)));
+    connect(&database, SIGNAL(serverUnreachable(QString)), this, SLOT(slotServerUnreachable(QString)));
+    connect(ui->pushButtonRunBenchmarks, SIGNAL(pressed()), this, SLOT(slotRunBenchmarks()));
+    connect(&benchmarkWatcher, SIGNAL(finished()), this, SLOT(slotBenchmarksFinished()));
+    connect(ui->pushButtonExportRoofline, SIGNAL(pressed()), this, SLOT(slotExportRoofline()));
 
     // Optimize the UI for mobile platforms
 #if defined(ANDROID)
@@ -104,6 +111,8 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    // Benchmarks access the device list, so they need to finish before it's destroyed
+    benchmarkWatcher.waitForFinished();
     delete ui;
 }
 
@@ -118,6 +127,7 @@ void MainWindow::updateDeviceList()
     if (devices.size() > 0)
     {
         displayDevice(0);
+        checkReportDatabaseState();
     }
     else
     {
@@ -139,7 +149,8 @@ void MainWindow::displayDevice(uint32_t index)
     displayPlatformExtensions(*device.platform);
     displayPlatformInfo(*device.platform);
     displayOperatingSystem();
-    checkReportDatabaseState();
+    displayBenchmarks(device);
+    displayReportState();
 }
 
 void MainWindow::connectFilterAndModel(QStandardItemModel& model, TreeProxyFilter& filter)
@@ -247,7 +258,23 @@ void MainWindow::displayDeviceImageFormats(DeviceInfo& device)
         CL_MEM_KERNEL_READ_AND_WRITE
     };
 
-    models.deviceImageFormats.setHorizontalHeaderLabels({"Format", "Order", "Type", "Read/Write", "Read only", "Write only", "Kernel Read/Write"});
+    // Throughput values of the image format benchmark (if it has been run) are added as additional columns for 2D images
+    const QStringList benchmarkDetails = { "sampler read, nearest, unnormalized", "sampler read, linear, unnormalized", "write", "read relative to buffer" };
+    std::unordered_map<QString, BenchmarkValue*> benchmarkValues;
+    const QString imageBenchmarkName = ImageBenchmark().name();
+    for (auto& result : device.benchmarkResults) {
+        if (result.name == imageBenchmarkName) {
+            for (auto& value : result.values) {
+                benchmarkValues[value.name + "\n" + value.detail] = &value;
+            }
+        }
+    }
+
+    QStringList headerLabels = {"Format", "Order", "Type", "Read/Write", "Read only", "Write only", "Kernel Read/Write"};
+    if (!benchmarkValues.empty()) {
+        headerLabels << "Sampler read" << "Linear read" << "Write" << "Read vs. buffer";
+    }
+    models.deviceImageFormats.setHorizontalHeaderLabels(headerLabels);
     ui->treeViewDeviceImageFormats->setHeaderHidden(false);
 
     QStandardItem* rootItem = models.deviceImageFormats.invisibleRootItem();
@@ -277,6 +304,14 @@ void MainWindow::displayDeviceImageFormats(DeviceInfo& device)
                     }
                     colIndex++;
                 }
+                if (!benchmarkValues.empty()) {
+                    const QString formatName = ImageBenchmark::formatName({ channelOrder.first, channelType.first });
+                    for (auto& detail : benchmarkDetails) {
+                        auto benchmarkValue = benchmarkValues.find(formatName + "\n" + detail);
+                        const bool measured = (imageType.first == CL_MEM_OBJECT_IMAGE2D) && (benchmarkValue != benchmarkValues.end());
+                        imageTypeItem << new QStandardItem(measured ? benchmarkValue->second->getDisplayValue() : "");
+                    }
+                }
                 rootItem->appendRow(imageTypeItem);
             }
         }
@@ -375,6 +410,36 @@ void MainWindow::displayOperatingSystem()
     }
 }
 
+void MainWindow::displayBenchmarks(DeviceInfo& device)
+{
+    models.benchmarks.clear();
+    QStandardItem* rootItem = models.benchmarks.invisibleRootItem();
+    for (auto& result : device.benchmarkResults) {
+        QList<QStandardItem*> benchmarkItem;
+        benchmarkItem << new QStandardItem(result.name);
+        benchmarkItem << new QStandardItem(result.message);
+        if (!result.message.isEmpty()) {
+            benchmarkItem[1]->setForeground(QColor::fromRgb(128, 128, 128));
+        }
+        for (auto& value : result.values) {
+            QList<QStandardItem*> valueItem;
+            QString caption = value.name;
+            if (!value.detail.isEmpty()) {
+                caption += " - " + value.detail;
+            }
+            valueItem << new QStandardItem(caption);
+            valueItem << new QStandardItem(value.getDisplayValue());
+            benchmarkItem.first()->appendRow(valueItem);
+        }
+        rootItem->appendRow(benchmarkItem);
+    }
+    ui->treeViewBenchmarks->expandAll();
+    ui->treeViewBenchmarks->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    ui->rooflineChart->setRoofline(device.roofline);
+    ui->rooflineChart->setVisible(device.roofline.valid());
+    ui->pushButtonExportRoofline->setEnabled(device.roofline.valid());
+}
+
 void MainWindow::setReportState(ReportState state)
 {
     reportState = state;
@@ -406,30 +471,96 @@ void MainWindow::setReportState(ReportState state)
     }
 }
 
-void MainWindow::checkReportDatabaseState()
+void MainWindow::displayReportState()
 {
-    qInfo() << "Checking report state against database for device" << devices[selectedDeviceIndex].identifier.name;
-    ui->labelReportDatabaseState->setText("<font color='#000000'>Connecting to database...</font>");
-    ui->toolButtonOnlineDevice->setEnabled(false);
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-    QString message;
-    if (!database.checkServerConnection(message))
+    if (!databaseError.isEmpty())
     {
-        qInfo() << "Unable to reach server";
+        ui->toolButtonUpload->setEnabled(false);
+        ui->toolButtonOnlineDevice->setEnabled(false);
         ui->labelReportDatabaseState->setText("<font color='#FF0000'>Could not connect to the database!\n\nPlease check your internet connection and proxy settings!</font>");
-        QApplication::restoreOverrideCursor();
         return;
     }
-    QJsonObject jsonReport;
-    Report report;
-    report.toJson(devices[selectedDeviceIndex], "", "", jsonReport);
-    ReportState state;
-    if (database.getReportState(jsonReport, state))
+    auto cachedState = reportStates.find(selectedDeviceIndex);
+    if (cachedState == reportStates.end())
+    {
+        // State for this device has not yet been received
+        ui->toolButtonUpload->setEnabled(false);
+        ui->toolButtonOnlineDevice->setEnabled(false);
+        ui->labelReportDatabaseState->setText("<font color='#000000'>Connecting to database...</font>");
+        return;
+    }
+    setReportState(cachedState->second);
+}
+
+void MainWindow::checkReportDatabaseState()
+{
+    // Invalidates all cached states and fetches them again for all devices in the background
+    qInfo() << "Checking report states against database for all devices";
+    // Replies of a previous check would refer to the request list that is rebuilt below
+    database.cancelReportStateRequests();
+    reportStates.clear();
+    reportHashes.clear();
+    reportStateRequests.clear();
+    databaseError.clear();
+    QList<QJsonObject> jsonReports;
+    std::unordered_map<QString, size_t> requestIndices;
+    for (int i = 0; i < static_cast<int>(devices.size()); i++)
+    {
+        Report report;
+        const QString hash = report.contentHash(devices[i]);
+        reportHashes.push_back(hash);
+        // Identical reports that have already been confirmed by the database don't need to be checked again
+        if (database.isSubmissionConfirmed(hash))
+        {
+            qInfo() << "Report for device" << devices[i].identifier.name << "matches a confirmed submission";
+            reportStates[i] = ReportState::is_present;
+            continue;
+        }
+        // Identical reports (e.g. multiple devices of the same type) are only checked once
+        auto request = requestIndices.find(hash);
+        if (request != requestIndices.end())
+        {
+            reportStateRequests[request->second].push_back(i);
+            continue;
+        }
+        requestIndices[hash] = reportStateRequests.size();
+        reportStateRequests.push_back({ i });
+        QJsonObject jsonReport;
+        report.toJson(devices[i], "", "", jsonReport);
+        jsonReports.append(jsonReport);
+    }
+    displayReportState();
+    if (!jsonReports.isEmpty())
+    {
+        database.requestReportStates(jsonReports);
+    }
+}
+
+void MainWindow::slotReportStateReceived(int index, ReportState state)
+{
+    if ((index < 0) || (index >= static_cast<int>(reportStateRequests.size())))
+    {
+        return;
+    }
+    for (int deviceIndex : reportStateRequests[index])
     {
-        qInfo() << "Got valid state from database";
-        setReportState(state);
+        qInfo() << "Got report state from database for device" << devices[deviceIndex].identifier.name;
+        reportStates[deviceIndex] = state;
+        if (state == ReportState::is_present)
+        {
+            database.confirmSubmission(reportHashes[deviceIndex]);
+        }
+        if (deviceIndex == selectedDeviceIndex)
+        {
+            displayReportState();
+        }
     }
-    QApplication::restoreOverrideCursor();
+}
+
+void MainWindow::slotServerUnreachable(QString message)
+{
+    databaseError = message;
+    displayReportState();
 }
 
 void MainWindow::slotAbout()
@@ -520,6 +651,7 @@ void MainWindow::slotUploadReport()
             report.toJson(devices[selectedDeviceIndex], dialog.getSubmitter(), dialog.getComment(), jsonReport);
             if (database.uploadReport(jsonReport, message))
             {
+                database.confirmSubmission(report.contentHash(devices[selectedDeviceIndex]));
                 QMessageBox::information(this, "Report submitted", "Your report has been uploaded to the database!\n\nThank you for your contribution!");
                 checkReportDatabaseState();
             }
@@ -532,6 +664,50 @@ void MainWindow::slotUploadReport()
     }
 }
 
+void MainWindow::slotRunBenchmarks()
+{
+    if (benchmarkWatcher.isRunning()) {
+        return;
+    }
+    benchmarkDeviceIndex = selectedDeviceIndex;
+    ui->pushButtonRunBenchmarks->setEnabled(false);
+    ui->labelBenchmarkState->setText("Running benchmarks for " + devices[benchmarkDeviceIndex].identifier.name + "...");
+    const int deviceIndex = benchmarkDeviceIndex;
+    benchmarkWatcher.setFuture(QtConcurrent::run([deviceIndex]() {
+        BenchmarkRunner benchmarkRunner;
+        return benchmarkRunner.run(devices[deviceIndex], QStringList(), BenchmarkSettings());
+    }));
+}
+
+void MainWindow::slotBenchmarksFinished()
+{
+    DeviceInfo& device = devices[benchmarkDeviceIndex];
+    const BenchmarkRunResults results = benchmarkWatcher.result();
+    device.benchmarkResults = results.benchmarks;
+    device.partitions = results.partitions;
+    device.roofline = results.roofline;
+    device.timerCalibration = results.timerCalibration;
+    ui->pushButtonRunBenchmarks->setEnabled(true);
+    ui->labelBenchmarkState->setText("Benchmarks finished for " + device.identifier.name);
+    if (benchmarkDeviceIndex == selectedDeviceIndex) {
+        displayDeviceImageFormats(device);
+        displayBenchmarks(device);
+    }
+}
+
+void MainWindow::slotExportRoofline()
+{
+    DeviceInfo& device = devices[selectedDeviceIndex];
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export roofline"), device.identifier.name + " roofline.json", tr("json (*.json);;csv (*.csv)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QString error;
+    if (!device.roofline.exportTo(fileName, error)) {
+        QMessageBox::warning(this, "Error", "The roofline could not be exported:\n" + error);
+    }
+}
+
 void MainWindow::slotFilterDeviceInfo(QString text)
 {
     QRegularExpression regExp(text, QRegularExpression::CaseInsensitiveOption);
@@ -37,6 +37,8 @@
 #include <QFileDialog>
 #include <QDesktopServices>
 #include <QStyleFactory>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #if defined(ANDROID)
 #include <QScroller>
 #endif
@@ -54,6 +56,8 @@
 #include "openclinfo.h"
 #include "appinfo.h"
 #include "report.h"
+#include "benchmark.h"
+#include "benchmarks.h"
 #include "CL/cl.h"
 
 QT_BEGIN_NAMESPACE
@@ -78,6 +82,13 @@ private:
 
     int selectedDeviceIndex = 0;
 
+    // Report states are fetched in the background for all devices and cached per device index
+    std::unordered_map<int, ReportState> reportStates;
+    QString databaseError;
+    // Content hash of each device's report, devices with identical reports share a single state request
+    std::vector<QString> reportHashes;
+    std::vector<std::vector<int>> reportStateRequests;
+
     struct FilterProxies {
         TreeProxyFilter deviceinfo;
         TreeProxyFilter deviceExtensions;
@@ -91,8 +102,13 @@ private:
         QStandardItemModel deviceImageFormats;
         QStandardItemModel platformInfo;
         QStandardItemModel platformExtensions;
+        QStandardItemModel benchmarks;
     } models;    
 
+    // Benchmarks are run in the background for a single device at a time
+    QFutureWatcher<BenchmarkRunResults> benchmarkWatcher;
+    int benchmarkDeviceIndex = -1;
+
     void connectFilterAndModel(QStandardItemModel& model, TreeProxyFilter& filter);
 
     void displayDeviceInfo(DeviceInfo &device);
@@ -101,8 +117,10 @@ private:
     void displayPlatformInfo(PlatformInfo& platform);
     void displayPlatformExtensions(PlatformInfo& platform);
     void displayOperatingSystem();
+    void displayBenchmarks(DeviceInfo& device);
 
     void setReportState(ReportState state);
+    void displayReportState();
     void checkReportDatabaseState();
 
 #if defined(ANDROID)
@@ -122,5 +140,10 @@ private Q_SLOTS:
     void slotFilterDeviceImageFormats(QString text);
     void slotFilterPlatformInfo(QString text);
     void slotFilterPlatformExtensions(QString text);
+    void slotReportStateReceived(int index, ReportState state);
+    void slotServerUnreachable(QString message);
+    void slotRunBenchmarks();
+    void slotBenchmarksFinished();
+    void slotExportRoofline();
 };
 #endif // MAINWINDOW_H
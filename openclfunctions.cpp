@@ -24,32 +24,109 @@ PFN_clGetPlatformIDs _clGetPlatformIDs = nullptr;
 PFN_clGetPlatformInfo _clGetPlatformInfo = nullptr;
 PFN_clGetDeviceIDs _clGetDeviceIDs = nullptr;
 PFN_clGetDeviceInfo _clGetDeviceInfo = nullptr;
+PFN_clCreateSubDevices _clCreateSubDevices = nullptr;
+PFN_clReleaseDevice _clReleaseDevice = nullptr;
+PFN_clGetDeviceAndHostTimer _clGetDeviceAndHostTimer = nullptr;
+PFN_clGetHostTimer _clGetHostTimer = nullptr;
 PFN_clCreateContext _clCreateContext = nullptr;
 PFN_clReleaseContext _clReleaseContext = nullptr;
 PFN_clGetSupportedImageFormats _clGetSupportedImageFormats = nullptr;
+PFN_clCreateCommandQueue _clCreateCommandQueue = nullptr;
+PFN_clCreateCommandQueueWithProperties _clCreateCommandQueueWithProperties = nullptr;
+PFN_clReleaseCommandQueue _clReleaseCommandQueue = nullptr;
+PFN_clCreateBuffer _clCreateBuffer = nullptr;
+PFN_clCreateImage _clCreateImage = nullptr;
+PFN_clCreateImage2D _clCreateImage2D = nullptr;
+PFN_clReleaseMemObject _clReleaseMemObject = nullptr;
+PFN_clCreateProgramWithSource _clCreateProgramWithSource = nullptr;
+PFN_clBuildProgram _clBuildProgram = nullptr;
+PFN_clGetProgramBuildInfo _clGetProgramBuildInfo = nullptr;
+PFN_clCreateProgramWithBinary _clCreateProgramWithBinary = nullptr;
+PFN_clCreateProgramWithIL _clCreateProgramWithIL = nullptr;
+PFN_clGetProgramInfo _clGetProgramInfo = nullptr;
+PFN_clReleaseProgram _clReleaseProgram = nullptr;
+PFN_clCreateKernel _clCreateKernel = nullptr;
+PFN_clReleaseKernel _clReleaseKernel = nullptr;
+PFN_clSetKernelArg _clSetKernelArg = nullptr;
+PFN_clGetKernelWorkGroupInfo _clGetKernelWorkGroupInfo = nullptr;
+PFN_clEnqueueNDRangeKernel _clEnqueueNDRangeKernel = nullptr;
+PFN_clEnqueueReadBuffer _clEnqueueReadBuffer = nullptr;
+PFN_clEnqueueWriteBuffer _clEnqueueWriteBuffer = nullptr;
+PFN_clEnqueueMapBuffer _clEnqueueMapBuffer = nullptr;
+PFN_clEnqueueUnmapMemObject _clEnqueueUnmapMemObject = nullptr;
+PFN_clFlush _clFlush = nullptr;
+PFN_clFinish _clFinish = nullptr;
+PFN_clWaitForEvents _clWaitForEvents = nullptr;
+PFN_clGetEventProfilingInfo _clGetEventProfilingInfo = nullptr;
+PFN_clReleaseEvent _clReleaseEvent = nullptr;
+PFN_clSetEventCallback _clSetEventCallback = nullptr;
+PFN_clGetExtensionFunctionAddressForPlatform _clGetExtensionFunctionAddressForPlatform = nullptr;
+PFN_clSVMAlloc _clSVMAlloc = nullptr;
+PFN_clSVMFree _clSVMFree = nullptr;
+PFN_clSetKernelArgSVMPointer _clSetKernelArgSVMPointer = nullptr;
+PFN_clEnqueueSVMMap _clEnqueueSVMMap = nullptr;
+PFN_clEnqueueSVMUnmap _clEnqueueSVMUnmap = nullptr;
 
-void loadFunctionPointers(void *library)
-{
-    qInfo() << "Loading OpenCL function pointers";
+// Function pointers are resolved by name from the dynamically loaded OpenCL library
 #if defined(_WIN32)
-    _clGetPlatformIDs = reinterpret_cast<PFN_clGetPlatformIDs>(GetProcAddress((HMODULE)library, "clGetPlatformIDs"));
-    _clGetPlatformInfo = reinterpret_cast<PFN_clGetPlatformInfo>(GetProcAddress((HMODULE)library, "clGetPlatformInfo"));
-    _clGetDeviceIDs = reinterpret_cast<PFN_clGetDeviceIDs>(GetProcAddress((HMODULE)library, "clGetDeviceIDs"));
-    _clGetDeviceInfo = reinterpret_cast<PFN_clGetDeviceInfo>(GetProcAddress((HMODULE)library, "clGetDeviceInfo"));
-    _clCreateContext = reinterpret_cast<PFN_clCreateContext>(GetProcAddress((HMODULE)library, "clCreateContext"));
-    _clReleaseContext = reinterpret_cast<PFN_clReleaseContext>(GetProcAddress((HMODULE)library, "clReleaseContext"));
-    _clGetSupportedImageFormats = reinterpret_cast<PFN_clGetSupportedImageFormats>(GetProcAddress((HMODULE)library, "clGetSupportedImageFormats"));
+#define LOAD_FUNCTION_POINTER(name) _##name = reinterpret_cast<PFN_##name>(GetProcAddress((HMODULE)library, #name))
 #else
-    _clGetPlatformIDs = reinterpret_cast<PFN_clGetPlatformIDs>(dlsym(library, "clGetPlatformIDs"));
-    _clGetPlatformInfo = reinterpret_cast<PFN_clGetPlatformInfo>(dlsym(library, "clGetPlatformInfo"));
-    _clGetDeviceIDs = reinterpret_cast<PFN_clGetDeviceIDs>(dlsym(library, "clGetDeviceIDs"));
-    _clGetDeviceInfo = reinterpret_cast<PFN_clGetDeviceInfo>(dlsym(library, "clGetDeviceInfo"));
-    _clCreateContext = reinterpret_cast<PFN_clCreateContext>(dlsym(library, "clCreateContext"));
-    _clReleaseContext = reinterpret_cast<PFN_clReleaseContext>(dlsym(library, "clReleaseContext"));
-    _clGetSupportedImageFormats = reinterpret_cast<PFN_clGetSupportedImageFormats>(dlsym(library, "clGetSupportedImageFormats"));
+#define LOAD_FUNCTION_POINTER(name) _##name = reinterpret_cast<PFN_##name>(dlsym(library, #name))
 #endif
+
+void loadFunctionPointers(void *library)
+{
+    qInfo() << "Loading OpenCL function pointers";
+    LOAD_FUNCTION_POINTER(clGetPlatformIDs);
+    LOAD_FUNCTION_POINTER(clGetPlatformInfo);
+    LOAD_FUNCTION_POINTER(clGetDeviceIDs);
+    LOAD_FUNCTION_POINTER(clGetDeviceInfo);
+    LOAD_FUNCTION_POINTER(clCreateSubDevices);
+    LOAD_FUNCTION_POINTER(clReleaseDevice);
+    LOAD_FUNCTION_POINTER(clGetDeviceAndHostTimer);
+    LOAD_FUNCTION_POINTER(clGetHostTimer);
+    LOAD_FUNCTION_POINTER(clCreateContext);
+    LOAD_FUNCTION_POINTER(clReleaseContext);
+    LOAD_FUNCTION_POINTER(clGetSupportedImageFormats);
+    LOAD_FUNCTION_POINTER(clCreateCommandQueue);
+    LOAD_FUNCTION_POINTER(clCreateCommandQueueWithProperties);
+    LOAD_FUNCTION_POINTER(clReleaseCommandQueue);
+    LOAD_FUNCTION_POINTER(clCreateBuffer);
+    LOAD_FUNCTION_POINTER(clCreateImage);
+    LOAD_FUNCTION_POINTER(clCreateImage2D);
+    LOAD_FUNCTION_POINTER(clReleaseMemObject);
+    LOAD_FUNCTION_POINTER(clCreateProgramWithSource);
+    LOAD_FUNCTION_POINTER(clBuildProgram);
+    LOAD_FUNCTION_POINTER(clGetProgramBuildInfo);
+    LOAD_FUNCTION_POINTER(clCreateProgramWithBinary);
+    LOAD_FUNCTION_POINTER(clCreateProgramWithIL);
+    LOAD_FUNCTION_POINTER(clGetProgramInfo);
+    LOAD_FUNCTION_POINTER(clReleaseProgram);
+    LOAD_FUNCTION_POINTER(clCreateKernel);
+    LOAD_FUNCTION_POINTER(clReleaseKernel);
+    LOAD_FUNCTION_POINTER(clSetKernelArg);
+    LOAD_FUNCTION_POINTER(clGetKernelWorkGroupInfo);
+    LOAD_FUNCTION_POINTER(clEnqueueNDRangeKernel);
+    LOAD_FUNCTION_POINTER(clEnqueueReadBuffer);
+    LOAD_FUNCTION_POINTER(clEnqueueWriteBuffer);
+    LOAD_FUNCTION_POINTER(clEnqueueMapBuffer);
+    LOAD_FUNCTION_POINTER(clEnqueueUnmapMemObject);
+    LOAD_FUNCTION_POINTER(clFlush);
+    LOAD_FUNCTION_POINTER(clFinish);
+    LOAD_FUNCTION_POINTER(clWaitForEvents);
+    LOAD_FUNCTION_POINTER(clGetEventProfilingInfo);
+    LOAD_FUNCTION_POINTER(clReleaseEvent);
+    LOAD_FUNCTION_POINTER(clSetEventCallback);
+    LOAD_FUNCTION_POINTER(clGetExtensionFunctionAddressForPlatform);
+    LOAD_FUNCTION_POINTER(clSVMAlloc);
+    LOAD_FUNCTION_POINTER(clSVMFree);
+    LOAD_FUNCTION_POINTER(clSetKernelArgSVMPointer);
+    LOAD_FUNCTION_POINTER(clEnqueueSVMMap);
+    LOAD_FUNCTION_POINTER(clEnqueueSVMUnmap);
 }
 
+#undef LOAD_FUNCTION_POINTER
+
 bool checkOpenCLAvailability(QString& error)
 {
     // Check if OpenCL is supported by trying to load the OpenCL library and getting a valid function pointer
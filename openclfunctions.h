@@ -36,17 +36,95 @@ typedef cl_int (*PFN_clGetPlatformIDs) (cl_uint, cl_platform_id *, cl_uint *);
 typedef cl_int (*PFN_clGetPlatformInfo) (cl_platform_id, cl_platform_info, size_t, void *, size_t *);
 typedef cl_int (*PFN_clGetDeviceIDs) (cl_platform_id, cl_device_type, cl_uint, cl_device_id *, cl_uint *);
 typedef cl_int (*PFN_clGetDeviceInfo) (cl_device_id, cl_device_info, size_t, void *, size_t *);
+typedef cl_int (*PFN_clCreateSubDevices) (cl_device_id, const cl_device_partition_property *, cl_uint, cl_device_id *, cl_uint *);
+typedef cl_int (*PFN_clReleaseDevice) (cl_device_id);
+typedef cl_int (*PFN_clGetDeviceAndHostTimer) (cl_device_id, cl_ulong *, cl_ulong *);
+typedef cl_int (*PFN_clGetHostTimer) (cl_device_id, cl_ulong *);
 typedef cl_context (*PFN_clCreateContext) (const cl_context_properties *, cl_uint, const cl_device_id *, F_PFN_notify, void *, cl_int *);
 typedef cl_int (*PFN_clReleaseContext) (cl_context);
 typedef cl_int (*PFN_clGetSupportedImageFormats) (cl_context, cl_mem_flags, cl_mem_object_type, cl_uint, cl_image_format *, cl_uint *);
+typedef cl_command_queue (*PFN_clCreateCommandQueue) (cl_context, cl_device_id, cl_command_queue_properties, cl_int *);
+typedef cl_command_queue (*PFN_clCreateCommandQueueWithProperties) (cl_context, cl_device_id, const cl_queue_properties *, cl_int *);
+typedef cl_int (*PFN_clReleaseCommandQueue) (cl_command_queue);
+typedef cl_mem (*PFN_clCreateBuffer) (cl_context, cl_mem_flags, size_t, void *, cl_int *);
+typedef cl_mem (*PFN_clCreateImage) (cl_context, cl_mem_flags, const cl_image_format *, const cl_image_desc *, void *, cl_int *);
+typedef cl_mem (*PFN_clCreateImage2D) (cl_context, cl_mem_flags, const cl_image_format *, size_t, size_t, size_t, void *, cl_int *);
+typedef cl_int (*PFN_clReleaseMemObject) (cl_mem);
+typedef cl_program (*PFN_clCreateProgramWithSource) (cl_context, cl_uint, const char **, const size_t *, cl_int *);
+typedef cl_int (*PFN_clBuildProgram) (cl_program, cl_uint, const cl_device_id *, const char *, void (CL_CALLBACK *)(cl_program, void *), void *);
+typedef cl_int (*PFN_clGetProgramBuildInfo) (cl_program, cl_device_id, cl_program_build_info, size_t, void *, size_t *);
+typedef cl_program (*PFN_clCreateProgramWithBinary) (cl_context, cl_uint, const cl_device_id *, const size_t *, const unsigned char **, cl_int *, cl_int *);
+typedef cl_program (*PFN_clCreateProgramWithIL) (cl_context, const void *, size_t, cl_int *);
+typedef cl_int (*PFN_clGetProgramInfo) (cl_program, cl_program_info, size_t, void *, size_t *);
+typedef cl_int (*PFN_clReleaseProgram) (cl_program);
+typedef cl_kernel (*PFN_clCreateKernel) (cl_program, const char *, cl_int *);
+typedef cl_int (*PFN_clReleaseKernel) (cl_kernel);
+typedef cl_int (*PFN_clSetKernelArg) (cl_kernel, cl_uint, size_t, const void *);
+typedef cl_int (*PFN_clGetKernelWorkGroupInfo) (cl_kernel, cl_device_id, cl_kernel_work_group_info, size_t, void *, size_t *);
+typedef cl_int (*PFN_clEnqueueNDRangeKernel) (cl_command_queue, cl_kernel, cl_uint, const size_t *, const size_t *, const size_t *, cl_uint, const cl_event *, cl_event *);
+typedef cl_int (*PFN_clEnqueueReadBuffer) (cl_command_queue, cl_mem, cl_bool, size_t, size_t, void *, cl_uint, const cl_event *, cl_event *);
+typedef cl_int (*PFN_clEnqueueWriteBuffer) (cl_command_queue, cl_mem, cl_bool, size_t, size_t, const void *, cl_uint, const cl_event *, cl_event *);
+typedef void* (*PFN_clEnqueueMapBuffer) (cl_command_queue, cl_mem, cl_bool, cl_map_flags, size_t, size_t, cl_uint, const cl_event *, cl_event *, cl_int *);
+typedef cl_int (*PFN_clEnqueueUnmapMemObject) (cl_command_queue, cl_mem, void *, cl_uint, const cl_event *, cl_event *);
+typedef cl_int (*PFN_clFlush) (cl_command_queue);
+typedef cl_int (*PFN_clFinish) (cl_command_queue);
+typedef cl_int (*PFN_clWaitForEvents) (cl_uint, const cl_event *);
+typedef cl_int (*PFN_clGetEventProfilingInfo) (cl_event, cl_profiling_info, size_t, void *, size_t *);
+typedef cl_int (*PFN_clReleaseEvent) (cl_event);
+typedef cl_int (*PFN_clSetEventCallback) (cl_event, cl_int, void (CL_CALLBACK *)(cl_event, cl_int, void *), void *);
+typedef void* (*PFN_clGetExtensionFunctionAddressForPlatform) (cl_platform_id, const char *);
+typedef void* (*PFN_clSVMAlloc) (cl_context, cl_svm_mem_flags, size_t, cl_uint);
+typedef void (*PFN_clSVMFree) (cl_context, void *);
+typedef cl_int (*PFN_clSetKernelArgSVMPointer) (cl_kernel, cl_uint, const void *);
+typedef cl_int (*PFN_clEnqueueSVMMap) (cl_command_queue, cl_bool, cl_map_flags, void *, size_t, cl_uint, const cl_event *, cl_event *);
+typedef cl_int (*PFN_clEnqueueSVMUnmap) (cl_command_queue, void *, cl_uint, const cl_event *, cl_event *);
 
 extern PFN_clGetPlatformIDs _clGetPlatformIDs;
 extern PFN_clGetPlatformInfo _clGetPlatformInfo;
 extern PFN_clGetDeviceIDs _clGetDeviceIDs;
 extern PFN_clGetDeviceInfo _clGetDeviceInfo;
+extern PFN_clCreateSubDevices _clCreateSubDevices;
+extern PFN_clReleaseDevice _clReleaseDevice;
+extern PFN_clGetDeviceAndHostTimer _clGetDeviceAndHostTimer;
+extern PFN_clGetHostTimer _clGetHostTimer;
 extern PFN_clCreateContext _clCreateContext;
 extern PFN_clReleaseContext _clReleaseContext;
 extern PFN_clGetSupportedImageFormats _clGetSupportedImageFormats;
+extern PFN_clCreateCommandQueue _clCreateCommandQueue;
+extern PFN_clCreateCommandQueueWithProperties _clCreateCommandQueueWithProperties;
+extern PFN_clReleaseCommandQueue _clReleaseCommandQueue;
+extern PFN_clCreateBuffer _clCreateBuffer;
+extern PFN_clCreateImage _clCreateImage;
+extern PFN_clCreateImage2D _clCreateImage2D;
+extern PFN_clReleaseMemObject _clReleaseMemObject;
+extern PFN_clCreateProgramWithSource _clCreateProgramWithSource;
+extern PFN_clBuildProgram _clBuildProgram;
+extern PFN_clGetProgramBuildInfo _clGetProgramBuildInfo;
+extern PFN_clCreateProgramWithBinary _clCreateProgramWithBinary;
+extern PFN_clCreateProgramWithIL _clCreateProgramWithIL;
+extern PFN_clGetProgramInfo _clGetProgramInfo;
+extern PFN_clReleaseProgram _clReleaseProgram;
+extern PFN_clCreateKernel _clCreateKernel;
+extern PFN_clReleaseKernel _clReleaseKernel;
+extern PFN_clSetKernelArg _clSetKernelArg;
+extern PFN_clGetKernelWorkGroupInfo _clGetKernelWorkGroupInfo;
+extern PFN_clEnqueueNDRangeKernel _clEnqueueNDRangeKernel;
+extern PFN_clEnqueueReadBuffer _clEnqueueReadBuffer;
+extern PFN_clEnqueueWriteBuffer _clEnqueueWriteBuffer;
+extern PFN_clEnqueueMapBuffer _clEnqueueMapBuffer;
+extern PFN_clEnqueueUnmapMemObject _clEnqueueUnmapMemObject;
+extern PFN_clFlush _clFlush;
+extern PFN_clFinish _clFinish;
+extern PFN_clWaitForEvents _clWaitForEvents;
+extern PFN_clGetEventProfilingInfo _clGetEventProfilingInfo;
+extern PFN_clReleaseEvent _clReleaseEvent;
+extern PFN_clSetEventCallback _clSetEventCallback;
+extern PFN_clGetExtensionFunctionAddressForPlatform _clGetExtensionFunctionAddressForPlatform;
+extern PFN_clSVMAlloc _clSVMAlloc;
+extern PFN_clSVMFree _clSVMFree;
+extern PFN_clSetKernelArgSVMPointer _clSetKernelArgSVMPointer;
+extern PFN_clEnqueueSVMMap _clEnqueueSVMMap;
+extern PFN_clEnqueueSVMUnmap _clEnqueueSVMUnmap;
 
 void loadFunctionPointers(void *library);
 bool checkOpenCLAvailability(QString& error);
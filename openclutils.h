@@ -286,6 +286,7 @@ namespace utils
 			STR(CL_DEVICE_PCIE_ID_AMD);
 			// cl_khr_command_buffer 
 			STR(CL_DEVICE_COMMAND_BUFFER_CAPABILITIES_KHR);
+			STR(CL_DEVICE_COMMAND_BUFFER_REQUIRED_QUEUE_PROPERTIES_KHR);
 
 #undef STR
 		default: return "?";
@@ -409,6 +410,77 @@ namespace utils
 		}
 	}
 
+	inline QString errorString(const cl_int error)
+	{
+		switch (error)
+		{
+#define STR(r) case CL_##r: return #r
+			STR(SUCCESS);
+			STR(DEVICE_NOT_FOUND);
+			STR(DEVICE_NOT_AVAILABLE);
+			STR(COMPILER_NOT_AVAILABLE);
+			STR(MEM_OBJECT_ALLOCATION_FAILURE);
+			STR(OUT_OF_RESOURCES);
+			STR(OUT_OF_HOST_MEMORY);
+			STR(PROFILING_INFO_NOT_AVAILABLE);
+			STR(MEM_COPY_OVERLAP);
+			STR(IMAGE_FORMAT_MISMATCH);
+			STR(IMAGE_FORMAT_NOT_SUPPORTED);
+			STR(BUILD_PROGRAM_FAILURE);
+			STR(MAP_FAILURE);
+			STR(MISALIGNED_SUB_BUFFER_OFFSET);
+			STR(EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+			STR(COMPILE_PROGRAM_FAILURE);
+			STR(LINKER_NOT_AVAILABLE);
+			STR(LINK_PROGRAM_FAILURE);
+			STR(DEVICE_PARTITION_FAILED);
+			STR(KERNEL_ARG_INFO_NOT_AVAILABLE);
+			STR(INVALID_VALUE);
+			STR(INVALID_DEVICE_TYPE);
+			STR(INVALID_PLATFORM);
+			STR(INVALID_DEVICE);
+			STR(INVALID_CONTEXT);
+			STR(INVALID_QUEUE_PROPERTIES);
+			STR(INVALID_COMMAND_QUEUE);
+			STR(INVALID_HOST_PTR);
+			STR(INVALID_MEM_OBJECT);
+			STR(INVALID_IMAGE_FORMAT_DESCRIPTOR);
+			STR(INVALID_IMAGE_SIZE);
+			STR(INVALID_SAMPLER);
+			STR(INVALID_BINARY);
+			STR(INVALID_BUILD_OPTIONS);
+			STR(INVALID_PROGRAM);
+			STR(INVALID_PROGRAM_EXECUTABLE);
+			STR(INVALID_KERNEL_NAME);
+			STR(INVALID_KERNEL_DEFINITION);
+			STR(INVALID_KERNEL);
+			STR(INVALID_ARG_INDEX);
+			STR(INVALID_ARG_VALUE);
+			STR(INVALID_ARG_SIZE);
+			STR(INVALID_KERNEL_ARGS);
+			STR(INVALID_WORK_DIMENSION);
+			STR(INVALID_WORK_GROUP_SIZE);
+			STR(INVALID_WORK_ITEM_SIZE);
+			STR(INVALID_GLOBAL_OFFSET);
+			STR(INVALID_EVENT_WAIT_LIST);
+			STR(INVALID_EVENT);
+			STR(INVALID_OPERATION);
+			STR(INVALID_BUFFER_SIZE);
+			STR(INVALID_GLOBAL_WORK_SIZE);
+			STR(INVALID_PROPERTY);
+			STR(INVALID_IMAGE_DESCRIPTOR);
+			STR(INVALID_COMPILER_OPTIONS);
+			STR(INVALID_LINKER_OPTIONS);
+			STR(INVALID_DEVICE_PARTITION_COUNT);
+			STR(INVALID_PIPE_SIZE);
+			STR(INVALID_DEVICE_QUEUE);
+			STR(INVALID_SPEC_ID);
+			STR(MAX_SIZE_RESTRICTION_EXCEEDED);
+#undef STR
+		default: return QString::number(error);
+		}
+	}
+
 	inline std::vector<std::string> explode(const std::string& str, char delimiter)
 	{
 		std::vector<std::string> tokens;
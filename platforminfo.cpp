@@ -19,6 +19,7 @@
 */
 
 #include <unordered_map>
+#include <algorithm>
 #include "platforminfo.h"
 
 PlatformInfoValueDescriptor::PlatformInfoValueDescriptor()
@@ -286,8 +287,11 @@ QJsonObject PlatformInfo::toJson()
 	QJsonObject jsonRoot;
 
 	// Extensions
+	// Sorted by name, so the same platform always results in the same report
+	std::vector<PlatformExtension> sortedExtensions = extensions;
+	std::sort(sortedExtensions.begin(), sortedExtensions.end(), [](const PlatformExtension& a, const PlatformExtension& b) { return a.name < b.name; });
 	QJsonArray jsonExtensions;
-	for (auto& ext : extensions)
+	for (auto& ext : sortedExtensions)
 	{
 		QJsonObject jsonNode;
 		jsonNode["name"] = ext.name;
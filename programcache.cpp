@@ -0,0 +1,115 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "programcache.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QFile>
+#include <QDir>
+#include <vector>
+
+ProgramBinaryCache::ProgramBinaryCache(DeviceInfo& device)
+{
+    const QString deviceKey = device.identifier.name + "\n" + device.identifier.deviceVersion + "\n" + device.identifier.driverVersion;
+    const QString deviceHash = QCryptographicHash::hash(deviceKey.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/programbinaries/" + deviceHash;
+}
+
+QString ProgramBinaryCache::fileName(const QString& source, const QString& options)
+{
+    const QByteArray key = source.toUtf8() + '\0' + options.toUtf8();
+    return path + "/" + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex() + ".bin";
+}
+
+QString ProgramBinaryCache::directory()
+{
+    return path;
+}
+
+bool ProgramBinaryCache::load(const QString& source, const QString& options, QByteArray& binary)
+{
+    QFile file(fileName(source, options));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    binary = file.readAll();
+    return !binary.isEmpty();
+}
+
+bool ProgramBinaryCache::store(const QString& source, const QString& options, const QByteArray& binary, QString& error)
+{
+    if (!QDir().mkpath(path)) {
+        error = "Could not create program binary cache directory " + path;
+        return false;
+    }
+    QFile file(fileName(source, options));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || (file.write(binary) != binary.size())) {
+        error = "Could not write program binary to " + file.fileName();
+        return false;
+    }
+    return true;
+}
+
+bool ProgramBinaryCache::remove(const QString& source, const QString& options)
+{
+    return QFile::remove(fileName(source, options));
+}
+
+bool ProgramBinaryCache::getBinary(cl_program program, QByteArray& binary, QString& error)
+{
+    size_t binarySize = 0;
+    cl_int status = _clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, nullptr);
+    if ((status != CL_SUCCESS) || (binarySize == 0)) {
+        error = "Could not get program binary size: " + utils::errorString(status);
+        return false;
+    }
+    binary.resize(qsizetype(binarySize));
+    unsigned char* binaryPtr = reinterpret_cast<unsigned char*>(binary.data());
+    status = _clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryPtr, nullptr);
+    if (status != CL_SUCCESS) {
+        error = "Could not get program binary: " + utils::errorString(status);
+        return false;
+    }
+    return true;
+}
+
+cl_program ProgramBinaryCache::createProgram(cl_context context, cl_device_id deviceId, const QByteArray& binary, const QString& options, QString& error)
+{
+    const size_t binarySize = binary.size();
+    const unsigned char* binaryPtr = reinterpret_cast<const unsigned char*>(binary.constData());
+    cl_int binaryStatus = CL_SUCCESS;
+    cl_int status = CL_SUCCESS;
+    cl_program program = _clCreateProgramWithBinary(context, 1, &deviceId, &binarySize, &binaryPtr, &binaryStatus, &status);
+    if ((status != CL_SUCCESS) || (binaryStatus != CL_SUCCESS)) {
+        error = "Could not create program from binary: " + utils::errorString((status != CL_SUCCESS) ? status : binaryStatus);
+        if (program) {
+            _clReleaseProgram(program);
+        }
+        return nullptr;
+    }
+    const QByteArray optionsData = options.toUtf8();
+    status = _clBuildProgram(program, 1, &deviceId, optionsData.constData(), nullptr, nullptr);
+    if (status != CL_SUCCESS) {
+        error = "Could not build program from binary: " + utils::errorString(status);
+        _clReleaseProgram(program);
+        return nullptr;
+    }
+    return program;
+}
@@ -0,0 +1,52 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include "CL/cl.h"
+#include "deviceinfo.h"
+#include "openclfunctions.h"
+#include "openclutils.h"
+#include <QString>
+#include <QByteArray>
+#include <QDebug>
+
+// On-disk cache for program binaries in the user's cache location
+// Binaries are stored in a directory per device and driver version, so a driver update never picks up stale binaries
+// Within that directory, files are named after a hash of the program source and the build options
+class ProgramBinaryCache
+{
+private:
+    QString path;
+    QString fileName(const QString& source, const QString& options);
+public:
+    ProgramBinaryCache(DeviceInfo& device);
+    QString directory();
+    bool load(const QString& source, const QString& options, QByteArray& binary);
+    bool store(const QString& source, const QString& options, const QByteArray& binary, QString& error);
+    bool remove(const QString& source, const QString& options);
+    // Reads the device binary of a program that has been built for a single device
+    static bool getBinary(cl_program program, QByteArray& binary, QString& error);
+    // Creates and builds a program from a device binary, building is still required but skips compilation
+    static cl_program createProgram(cl_context context, cl_device_id deviceId, const QByteArray& binary, const QString& options, QString& error);
+};
+
+#endif
@@ -39,10 +39,64 @@ void Report::toJson(DeviceInfo& device, QString submitter, QString comment, QJso
     jsonObject["device"] = device.toJson();
 }
 
+// Normalizes all strings of a json value (unicode composition and whitespace), object keys are already sorted by QJsonObject
+static QJsonValue normalizeJsonValue(const QJsonValue& value)
+{
+    if (value.isString()) {
+        return value.toString().normalized(QString::NormalizationForm_C).simplified();
+    }
+    if (value.isArray()) {
+        QJsonArray array;
+        for (const QJsonValue& item : value.toArray()) {
+            array.append(normalizeJsonValue(item));
+        }
+        return array;
+    }
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            it.value() = normalizeJsonValue(it.value());
+        }
+        return object;
+    }
+    return value;
+}
+
+QByteArray Report::toCanonicalJson(DeviceInfo& device)
+{
+    // Submitter and comment don't describe the device, so they're not part of the canonical form
+    QJsonObject jsonReport;
+    toJson(device, "", "", jsonReport);
+    QJsonObject jsonEnv = jsonReport["environment"].toObject();
+    jsonEnv.remove("submitter");
+    jsonEnv.remove("comment");
+    jsonEnv.remove("appversion");
+    jsonReport["environment"] = jsonEnv;
+    return QJsonDocument(normalizeJsonValue(jsonReport).toObject()).toJson(QJsonDocument::Compact);
+}
+
+QString Report::contentHash(DeviceInfo& device)
+{
+    return QString(QCryptographicHash::hash(toCanonicalJson(device), QCryptographicHash::Sha256).toHex());
+}
+
 void Report::saveToFile(DeviceInfo& device, QString fileName, QString submitter, QString comment)
 {
     QJsonObject jsonReport;
     toJson(device, submitter, comment, jsonReport);
+    // Measured values are only stored in local reports, they are not part of the database schema
+    if (!device.benchmarkResults.empty()) {
+        jsonReport["benchmarks"] = device.benchmarksToJson();
+    }
+    if (!device.partitions.empty()) {
+        jsonReport["partitions"] = device.partitionsToJson();
+    }
+    if (device.roofline.valid()) {
+        jsonReport["roofline"] = device.roofline.toJson();
+    }
+    if (device.timerCalibration.valid()) {
+        jsonReport["timercalibration"] = device.timerCalibration.toJson();
+    }
     QJsonDocument doc(jsonReport);
     QFile jsonFile(fileName);
     jsonFile.open(QFile::WriteOnly);
@@ -52,6 +106,17 @@ void Report::saveToFile(DeviceInfo& device, QString fileName, QString submitter,
 
 int Report::uploadNonVisual(DeviceInfo& device, QString submitter, QString comment)
 {
+    // An identical report has already been confirmed by the database, so there is no need to ask again
+    const QString hash = contentHash(device);
+    if (database.isSubmissionConfirmed(hash))
+    {
+#ifndef GUI_BUILD
+        std::cout << "Device already present in database\n";
+#endif
+        qWarning() << "Device already present in database (identical report already submitted)";
+        return -3;
+    }
+
     QString message;
     bool dbstatus = database.checkServerConnection(message);
     if (!dbstatus)
@@ -76,6 +141,7 @@ int Report::uploadNonVisual(DeviceInfo& device, QString submitter, QString comme
 
     if (reportId > -1)
     {
+        database.confirmSubmission(hash);
 #ifndef GUI_BUILD
         std::cout << "Device already present in database\n";
 #endif
@@ -85,6 +151,7 @@ int Report::uploadNonVisual(DeviceInfo& device, QString submitter, QString comme
 
     if (database.uploadReport(reportJson, message))
     {
+        database.confirmSubmission(hash);
 #ifndef GUI_BUILD
         std::cout << "Report successfully submitted. Thanks for your contribution!\n";
 #endif
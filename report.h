@@ -22,6 +22,7 @@
 #define REPORT_H
 
 #include <QFile>
+#include <QCryptographicHash>
 #include <iostream>
 #include "deviceinfo.h"
 #include "operatingsystem.h"
@@ -31,6 +32,8 @@
 class Report {
 public:
 	void toJson(DeviceInfo& device, QString submitter, QString comment, QJsonObject& jsonObject);
+	QByteArray toCanonicalJson(DeviceInfo& device);
+	QString contentHash(DeviceInfo& device);
 	void saveToFile(DeviceInfo& device, QString fileName, QString submitter, QString comment);
 	int uploadNonVisual(DeviceInfo& device, QString submitter, QString comment);
 };
@@ -0,0 +1,739 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "reportstore.h"
+#include "openclutils.h"
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <random>
+
+// Applies a predicate to all values of a column and combines the result with the current selection
+// Kept free of branches, so the compiler can vectorize the loop
+template<typename Predicate>
+static void scanColumn(const qint64* values, quint64 count, std::vector<quint8>& selection, Predicate predicate)
+{
+    quint8* selected = selection.data();
+    for (quint64 i = 0; i < count; i++) {
+        selected[i] &= static_cast<quint8>((values[i] != ReportStore::nullValue) & predicate(values[i]));
+    }
+}
+
+// Jaccard similarity of two extension bitsets (intersection over union)
+static Q_ALWAYS_INLINE double jaccardSimilarity(const quint64* a, const quint64* b, quint32 words, quint32 extraBits, quint32& hammingDistance)
+{
+    quint32 intersection = 0;
+    quint32 difference = 0;
+    for (quint32 i = 0; i < words; i++) {
+        intersection += qPopulationCount(a[i] & b[i]);
+        difference += qPopulationCount(a[i] ^ b[i]);
+    }
+    difference += extraBits;
+    hammingDistance = difference;
+    const quint32 unionCount = intersection + difference;
+    return (unionCount > 0) ? static_cast<double>(intersection) / unionCount : 1.0;
+}
+
+// qPopulationCount only compiles to the popcnt instruction if the target enables it. The default x86-64 target doesn't,
+// so every popcount would be a library call. On x86 the loops below are also built for popcnt and selected at runtime.
+#if (defined(Q_CC_GNU) || defined(Q_CC_CLANG)) && !defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+#define REPORTSTORE_POPCNT_DISPATCH
+#endif
+
+// Similarity of one bitset against the bitsets of all rows
+static Q_ALWAYS_INLINE void similarityScanImpl(const quint64* bits, const quint64* rowBits, quint64 rows, quint32 words, quint32 extraBits, double* similarities, quint32* distances)
+{
+    for (quint64 row = 0; row < rows; row++) {
+        similarities[row] = jaccardSimilarity(bits, &rowBits[row * words], words, extraBits, distances[row]);
+    }
+}
+
+// Index of the first leader at least as similar to the bitset as the threshold, -1 if there is none
+static Q_ALWAYS_INLINE qint64 findSimilarImpl(const quint64* bits, const quint64* leaderBits, quint64 leaders, quint32 words, double threshold)
+{
+    for (quint64 leader = 0; leader < leaders; leader++) {
+        quint32 distance;
+        if (jaccardSimilarity(&leaderBits[leader * words], bits, words, 0, distance) >= threshold) {
+            return static_cast<qint64>(leader);
+        }
+    }
+    return -1;
+}
+
+#ifdef REPORTSTORE_POPCNT_DISPATCH
+__attribute__((target("popcnt"))) static void similarityScanPopcnt(const quint64* bits, const quint64* rowBits, quint64 rows, quint32 words, quint32 extraBits, double* similarities, quint32* distances)
+{
+    similarityScanImpl(bits, rowBits, rows, words, extraBits, similarities, distances);
+}
+
+__attribute__((target("popcnt"))) static qint64 findSimilarPopcnt(const quint64* bits, const quint64* leaderBits, quint64 leaders, quint32 words, double threshold)
+{
+    return findSimilarImpl(bits, leaderBits, leaders, words, threshold);
+}
+#endif
+
+static void similarityScan(const quint64* bits, const quint64* rowBits, quint64 rows, quint32 words, quint32 extraBits, double* similarities, quint32* distances)
+{
+#ifdef REPORTSTORE_POPCNT_DISPATCH
+    if (__builtin_cpu_supports("popcnt")) {
+        similarityScanPopcnt(bits, rowBits, rows, words, extraBits, similarities, distances);
+        return;
+    }
+#endif
+    similarityScanImpl(bits, rowBits, rows, words, extraBits, similarities, distances);
+}
+
+static qint64 findSimilar(const quint64* bits, const quint64* leaderBits, quint64 leaders, quint32 words, double threshold)
+{
+#ifdef REPORTSTORE_POPCNT_DISPATCH
+    if (__builtin_cpu_supports("popcnt")) {
+        return findSimilarPopcnt(bits, leaderBits, leaders, words, threshold);
+    }
+#endif
+    return findSimilarImpl(bits, leaderBits, leaders, words, threshold);
+}
+
+ReportStore::ReportStore(const QString& path)
+{
+    this->path = path;
+}
+
+ReportStore::ParsedReport ReportStore::parseReport(const QString& fileName)
+{
+    ParsedReport report;
+    report.source = fileName;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return report;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if ((parseError.error != QJsonParseError::NoError) || !document.isObject()) {
+        return report;
+    }
+    const QJsonObject jsonDevice = document.object()["device"].toObject();
+    if (jsonDevice.isEmpty()) {
+        return report;
+    }
+    report.deviceName = jsonDevice["identifier"].toObject()["devicename"].toString();
+    for (const QJsonValue& jsonValue : jsonDevice["info"].toArray()) {
+        const QJsonObject jsonInfo = jsonValue.toObject();
+        const qint32 enumValue = jsonInfo["enumvalue"].toInt();
+        const QJsonValue value = jsonInfo["value"];
+        // Only scalar values are stored, strings and arrays are not queryable
+        if (value.isBool()) {
+            report.values.push_back({ enumValue, value.toBool() ? 1 : 0 });
+        }
+        if (value.isDouble()) {
+            report.values.push_back({ enumValue, value.toInteger(nullValue) });
+        }
+    }
+    for (const QJsonValue& jsonValue : jsonDevice["extensions"].toArray()) {
+        report.extensions.append(jsonValue.toObject()["name"].toString());
+    }
+    report.valid = true;
+    return report;
+}
+
+bool ReportStore::writeFile(const QString& fileName, const void* data, qint64 size, QString& error)
+{
+    QFile file(QDir(path).filePath(fileName));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = "Could not write " + file.fileName();
+        return false;
+    }
+    if ((size > 0) && (file.write(static_cast<const char*>(data), size) != size)) {
+        error = "Could not write " + file.fileName();
+        return false;
+    }
+    return true;
+}
+
+bool ReportStore::writeDictionary(const QString& fileName, const QStringList& values, QString& error)
+{
+    QStringList lines;
+    for (const QString& value : values) {
+        lines.append(QString(value).replace('\n', ' '));
+    }
+    const QByteArray data = lines.join('\n').toUtf8();
+    return writeFile(fileName, data.constData(), data.size(), error);
+}
+
+bool ReportStore::readDictionary(const QString& fileName, int count, QStringList& values, QString& error)
+{
+    QFile file(QDir(path).filePath(fileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Could not read " + file.fileName();
+        return false;
+    }
+    const QString data = QString::fromUtf8(file.readAll());
+    // The entry count comes from meta.json, as a dictionary with a single empty entry and an empty dictionary are the same file
+    values = (count == 0) ? QStringList() : data.split('\n');
+    if (values.size() != count) {
+        error = "Damaged report store file " + file.fileName() + ", please ingest the reports again";
+        return false;
+    }
+    return true;
+}
+
+const void* ReportStore::mapFile(const QString& fileName, qint64 expectedSize, QString& error)
+{
+    std::unique_ptr<QFile> file = std::make_unique<QFile>(QDir(path).filePath(fileName));
+    if (!file->open(QIODevice::ReadOnly) || (file->size() != expectedSize)) {
+        error = "Missing or damaged store file " + file->fileName();
+        return nullptr;
+    }
+    if (expectedSize == 0) {
+        return nullptr;
+    }
+    const uchar* data = file->map(0, expectedSize);
+    if (!data) {
+        error = "Could not map " + file->fileName();
+        return nullptr;
+    }
+    // The mapping stays valid as long as the file object is alive
+    mappedFiles.push_back(std::move(file));
+    return data;
+}
+
+bool ReportStore::ingest(const QString& reportDirectory, QString& error)
+{
+    QStringList fileNames;
+    QDirIterator dirIterator(reportDirectory, { "*.json" }, QDir::Files, QDirIterator::Subdirectories);
+    while (dirIterator.hasNext()) {
+        fileNames.append(dirIterator.next());
+    }
+    if (fileNames.isEmpty()) {
+        error = "No reports found in " + reportDirectory;
+        return false;
+    }
+    // Sorted so that ingesting the same directory always results in the same row order
+    std::sort(fileNames.begin(), fileNames.end());
+
+    QElapsedTimer timer;
+    timer.start();
+    const QList<ParsedReport> parsedReports = QtConcurrent::blockingMapped(fileNames, &ReportStore::parseReport);
+    qInfo() << "Parsed" << parsedReports.size() << "reports in" << timer.elapsed() << "ms";
+
+    std::vector<const ParsedReport*> reports;
+    for (const ParsedReport& report : parsedReports) {
+        if (report.valid) {
+            reports.push_back(&report);
+        } else {
+            qWarning() << "Skipping invalid report" << report.source;
+        }
+    }
+    const quint64 rows = reports.size();
+
+    // Dictionaries are sorted for stable ids
+    std::map<QString, quint32> deviceDictionary;
+    std::map<QString, quint32> extensionDictionary;
+    for (const ParsedReport* report : reports) {
+        deviceDictionary[report->deviceName] = 0;
+        for (const QString& extension : report->extensions) {
+            extensionDictionary[extension] = 0;
+        }
+    }
+    StoreColumns store;
+    for (auto& entry : deviceDictionary) {
+        entry.second = store.deviceNames.size();
+        store.deviceNames.append(entry.first);
+    }
+    for (auto& entry : extensionDictionary) {
+        entry.second = store.extensionNames.size();
+        store.extensionNames.append(entry.first);
+    }
+
+    store.deviceIds.resize(rows);
+    store.extensionOffsets.resize(rows + 1, 0);
+    store.extensionWords = (store.extensionNames.size() + 63) / 64;
+    store.extensionBits.resize(rows * store.extensionWords, 0);
+    for (quint64 row = 0; row < rows; row++) {
+        const ParsedReport* report = reports[row];
+        store.sources.append(QDir(reportDirectory).relativeFilePath(report->source));
+        store.deviceIds[row] = deviceDictionary[report->deviceName];
+        for (auto& value : report->values) {
+            std::vector<qint64>& column = store.values[value.first];
+            if (column.empty()) {
+                column.resize(rows, nullValue);
+            }
+            column[row] = value.second;
+        }
+        for (const QString& extension : report->extensions) {
+            const quint32 extensionId = extensionDictionary[extension];
+            store.extensionValues.push_back(extensionId);
+            store.extensionBits[row * store.extensionWords + extensionId / 64] |= 1ull << (extensionId % 64);
+        }
+        store.extensionOffsets[row + 1] = static_cast<quint32>(store.extensionValues.size());
+    }
+    if (!writeStore(store, error)) {
+        return false;
+    }
+    qInfo() << "Ingested" << rows << "reports with" << store.values.size() << "columns and" << store.extensionNames.size() << "distinct extensions in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool ReportStore::generate(quint64 rows, QString& error)
+{
+    // Reports are drawn from device families with a random extension set and fixed limits,
+    // each report then differs from its family by a few extensions (e.g. different driver versions)
+    static const quint32 extensionCount = 160;
+    static const quint32 familyCount = 256;
+    static const QStringList knownExtensions = { "cl_khr_fp16", "cl_khr_fp64", "cl_khr_int64_base_atomics", "cl_khr_subgroups", "cl_khr_il_program", "cl_khr_3d_image_writes", "cl_khr_command_buffer", "cl_khr_integer_dot_product" };
+    QElapsedTimer timer;
+    timer.start();
+    StoreColumns store;
+    store.extensionNames = knownExtensions;
+    for (quint32 i = store.extensionNames.size(); i < extensionCount; i++) {
+        store.extensionNames.append(QString("cl_synthetic_extension_%1").arg(i, 3, 10, QChar('0')));
+    }
+    // Dictionaries of ingested stores are sorted as well
+    store.extensionNames.sort();
+    for (quint32 family = 0; family < familyCount; family++) {
+        store.deviceNames.append(QString("Synthetic device %1").arg(family, 3, 10, QChar('0')));
+    }
+    store.extensionWords = (extensionCount + 63) / 64;
+
+    std::mt19937_64 generator(1);
+    std::bernoulli_distribution extensionSupported(0.4);
+    std::vector<quint64> familyBits(familyCount * store.extensionWords, 0);
+    std::vector<qint64> maxAllocSize(familyCount);
+    std::vector<qint64> computeUnits(familyCount);
+    std::vector<qint64> clockFrequency(familyCount);
+    for (quint32 family = 0; family < familyCount; family++) {
+        for (quint32 extension = 0; extension < extensionCount; extension++) {
+            if (extensionSupported(generator)) {
+                familyBits[family * store.extensionWords + extension / 64] |= 1ull << (extension % 64);
+            }
+        }
+        maxAllocSize[family] = qint64(1) << std::uniform_int_distribution<int>(28, 36)(generator);
+        computeUnits[family] = std::uniform_int_distribution<int>(1, 128)(generator);
+        clockFrequency[family] = std::uniform_int_distribution<int>(800, 3000)(generator);
+    }
+
+    std::uniform_int_distribution<quint32> familyDistribution(0, familyCount - 1);
+    std::uniform_int_distribution<quint32> extensionDistribution(0, extensionCount - 1);
+    std::uniform_int_distribution<quint32> flipDistribution(0, 3);
+    store.deviceIds.resize(rows);
+    store.extensionOffsets.resize(rows + 1, 0);
+    store.extensionBits.resize(rows * store.extensionWords, 0);
+    std::vector<qint64>& maxAllocSizeColumn = store.values[CL_DEVICE_MAX_MEM_ALLOC_SIZE];
+    std::vector<qint64>& globalMemSizeColumn = store.values[CL_DEVICE_GLOBAL_MEM_SIZE];
+    std::vector<qint64>& computeUnitsColumn = store.values[CL_DEVICE_MAX_COMPUTE_UNITS];
+    std::vector<qint64>& clockFrequencyColumn = store.values[CL_DEVICE_MAX_CLOCK_FREQUENCY];
+    maxAllocSizeColumn.resize(rows);
+    globalMemSizeColumn.resize(rows);
+    computeUnitsColumn.resize(rows);
+    clockFrequencyColumn.resize(rows);
+    for (quint64 row = 0; row < rows; row++) {
+        const quint32 family = familyDistribution(generator);
+        quint64* bits = &store.extensionBits[row * store.extensionWords];
+        std::copy(familyBits.begin() + family * store.extensionWords, familyBits.begin() + (family + 1) * store.extensionWords, bits);
+        for (quint32 flips = flipDistribution(generator); flips > 0; flips--) {
+            const quint32 extension = extensionDistribution(generator);
+            bits[extension / 64] ^= 1ull << (extension % 64);
+        }
+        for (quint32 extension = 0; extension < extensionCount; extension++) {
+            if ((bits[extension / 64] >> (extension % 64)) & 1) {
+                store.extensionValues.push_back(extension);
+            }
+        }
+        store.extensionOffsets[row + 1] = static_cast<quint32>(store.extensionValues.size());
+        store.deviceIds[row] = family;
+        store.sources.append(QString("synthetic/%1.json").arg(row));
+        maxAllocSizeColumn[row] = maxAllocSize[family];
+        globalMemSizeColumn[row] = maxAllocSize[family] * 4;
+        computeUnitsColumn[row] = computeUnits[family];
+        clockFrequencyColumn[row] = clockFrequency[family];
+    }
+    if (!writeStore(store, error)) {
+        return false;
+    }
+    qInfo() << "Generated" << rows << "synthetic reports in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool ReportStore::writeStore(const StoreColumns& store, QString& error)
+{
+    // Only remove files that belong to a store
+    QDir storeDir(path);
+    if (!storeDir.mkpath(".")) {
+        error = "Could not create store directory " + path;
+        return false;
+    }
+    for (const QString& fileName : storeDir.entryList({ "*.bin", "*.dict", "meta.json" }, QDir::Files)) {
+        storeDir.remove(fileName);
+    }
+
+    QJsonArray jsonColumns;
+    for (auto& column : store.values) {
+        const QString fileName = QString("column_%1.bin").arg(column.first, 4, 16, QChar('0'));
+        if (!writeFile(fileName, column.second.data(), column.second.size() * sizeof(qint64), error)) {
+            return false;
+        }
+        jsonColumns.append(column.first);
+    }
+    if (!writeDictionary("sources.dict", store.sources, error) ||
+        !writeDictionary("devices.dict", store.deviceNames, error) ||
+        !writeDictionary("extensions.dict", store.extensionNames, error) ||
+        !writeFile("devices.bin", store.deviceIds.data(), store.deviceIds.size() * sizeof(quint32), error) ||
+        !writeFile("extensions.offsets.bin", store.extensionOffsets.data(), store.extensionOffsets.size() * sizeof(quint32), error) ||
+        !writeFile("extensions.bin", store.extensionValues.data(), store.extensionValues.size() * sizeof(quint32), error) ||
+        !writeFile("extensions.bits.bin", store.extensionBits.data(), store.extensionBits.size() * sizeof(quint64), error)) {
+        return false;
+    }
+    QJsonObject jsonMeta;
+    jsonMeta["version"] = 3;
+    jsonMeta["rows"] = static_cast<qint64>(store.deviceIds.size());
+    jsonMeta["sources"] = static_cast<int>(store.sources.size());
+    jsonMeta["devices"] = static_cast<int>(store.deviceNames.size());
+    jsonMeta["extensions"] = static_cast<int>(store.extensionNames.size());
+    jsonMeta["extensionwords"] = static_cast<qint64>(store.extensionWords);
+    jsonMeta["columns"] = jsonColumns;
+    const QByteArray meta = QJsonDocument(jsonMeta).toJson(QJsonDocument::Indented);
+    return writeFile("meta.json", meta.constData(), meta.size(), error);
+}
+
+bool ReportStore::open(QString& error)
+{
+    QFile metaFile(QDir(path).filePath("meta.json"));
+    if (!metaFile.open(QIODevice::ReadOnly)) {
+        error = "Could not open report store in " + path;
+        return false;
+    }
+    const QJsonObject jsonMeta = QJsonDocument::fromJson(metaFile.readAll()).object();
+    if (jsonMeta["version"].toInt() != 3) {
+        error = "Unsupported report store version, please ingest the reports again";
+        return false;
+    }
+    rowCount = jsonMeta["rows"].toInteger();
+    if (!readDictionary("sources.dict", jsonMeta["sources"].toInt(), sources, error) ||
+        !readDictionary("devices.dict", jsonMeta["devices"].toInt(), deviceNames, error) ||
+        !readDictionary("extensions.dict", jsonMeta["extensions"].toInt(), extensionNames, error)) {
+        return false;
+    }
+    for (int i = 0; i < extensionNames.size(); i++) {
+        extensionIds[extensionNames[i]] = i;
+    }
+    error.clear();
+    deviceIds = static_cast<const quint32*>(mapFile("devices.bin", rowCount * sizeof(quint32), error));
+    extensionOffsets = static_cast<const quint32*>(mapFile("extensions.offsets.bin", (rowCount + 1) * sizeof(quint32), error));
+    if (!error.isEmpty()) {
+        return false;
+    }
+    extensionValues = static_cast<const quint32*>(mapFile("extensions.bin", extensionOffsets[rowCount] * sizeof(quint32), error));
+    extensionWords = jsonMeta["extensionwords"].toInt();
+    extensionBits = static_cast<const quint64*>(mapFile("extensions.bits.bin", rowCount * extensionWords * sizeof(quint64), error));
+    for (const QJsonValue& jsonColumn : jsonMeta["columns"].toArray()) {
+        Column column{};
+        column.enumValue = jsonColumn.toInt();
+        column.name = utils::deviceInfoString(column.enumValue);
+        if (column.name == "?") {
+            column.name = QString("0x%1").arg(column.enumValue, 4, 16, QChar('0'));
+        }
+        column.values = static_cast<const qint64*>(mapFile(QString("column_%1.bin").arg(column.enumValue, 4, 16, QChar('0')), rowCount * sizeof(qint64), error));
+        columns[column.name] = column;
+    }
+    return error.isEmpty();
+}
+
+bool ReportStore::filterRows(const QString& filter, std::vector<quint8>& selection, QString& error)
+{
+    selection.assign(rowCount, 1);
+    if (filter.trimmed().isEmpty()) {
+        return true;
+    }
+    static const QRegularExpression comparisonExpression("^\\s*(\\w+)\\s*(==|!=|>=|<=|>|<)\\s*(\\d+)\\s*(KiB|MiB|GiB|TiB)?\\s*$");
+    static const QRegularExpression extensionExpression("^\\s*(!?)\\s*(\\w+)\\s*$");
+    for (const QString& term : filter.split("&&")) {
+        QRegularExpressionMatch match = comparisonExpression.match(term);
+        if (match.hasMatch()) {
+            auto column = columns.find(match.captured(1));
+            if (column == columns.end()) {
+                error = "Unknown column " + match.captured(1);
+                return false;
+            }
+            qint64 operand = match.captured(3).toLongLong();
+            const QString unit = match.captured(4);
+            if (!unit.isEmpty()) {
+                operand <<= 10 * (QStringList({ "KiB", "MiB", "GiB", "TiB" }).indexOf(unit) + 1);
+            }
+            const qint64* values = column->second.values;
+            const QString op = match.captured(2);
+            if (op == "==") {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value == operand; });
+            } else if (op == "!=") {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value != operand; });
+            } else if (op == ">=") {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value >= operand; });
+            } else if (op == "<=") {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value <= operand; });
+            } else if (op == ">") {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value > operand; });
+            } else {
+                scanColumn(values, rowCount, selection, [operand](qint64 value) { return value < operand; });
+            }
+            continue;
+        }
+        match = extensionExpression.match(term);
+        if (match.hasMatch()) {
+            const bool negate = !match.captured(1).isEmpty();
+            auto extension = extensionIds.find(match.captured(2));
+            if (extension == extensionIds.end()) {
+                // Extension is not supported by any report in the store
+                if (!negate) {
+                    std::fill(selection.begin(), selection.end(), 0);
+                }
+                continue;
+            }
+            // Test the extension's bit in each report's bitset
+            const quint32 word = extension->second / 64;
+            const quint32 bit = extension->second % 64;
+            const quint8 expected = negate ? 0 : 1;
+            for (quint64 row = 0; row < rowCount; row++) {
+                const quint8 present = static_cast<quint8>((extensionBits[row * extensionWords + word] >> bit) & 1);
+                selection[row] &= static_cast<quint8>(present == expected);
+            }
+            continue;
+        }
+        error = "Invalid filter term \"" + term.trimmed() + "\"";
+        return false;
+    }
+    return true;
+}
+
+bool ReportStore::query(const QString& expression, QString& result, QString& error)
+{
+    // Expression format: [count() | min(column) | max(column) | sum(column) | avg(column)] [where] filter
+    // Filter terms are combined with &&, terms are either comparisons (CL_DEVICE_MAX_MEM_ALLOC_SIZE >= 16 GiB) or extension names (cl_khr_fp64, !cl_khr_fp16)
+    static const QRegularExpression whereExpression("^(.*?)\\bwhere\\b(.*)$", QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression aggregateExpression("^\\s*(count|min|max|sum|avg)\\s*\\(\\s*(\\w*)\\s*\\)\\s*$", QRegularExpression::CaseInsensitiveOption);
+    QString select;
+    QString filter = expression;
+    QRegularExpressionMatch match = whereExpression.match(expression);
+    if (match.hasMatch()) {
+        select = match.captured(1).trimmed();
+        filter = match.captured(2);
+    } else if (aggregateExpression.match(expression).hasMatch()) {
+        select = expression.trimmed();
+        filter.clear();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<quint8> selection;
+    if (!filterRows(filter, selection, error)) {
+        return false;
+    }
+    quint64 matches = 0;
+    for (quint8 selected : selection) {
+        matches += selected;
+    }
+
+    QTextStream output(&result);
+    if (select.isEmpty()) {
+        // List matching devices, counted by dictionary id (the dictionary is sorted, so the listing is ordered by name)
+        std::vector<quint64> deviceCounts(deviceNames.size(), 0);
+        for (quint64 row = 0; row < rowCount; row++) {
+            deviceCounts[deviceIds[row]] += selection[row];
+        }
+        for (int device = 0; device < deviceNames.size(); device++) {
+            if (deviceCounts[device] > 0) {
+                output << deviceCounts[device] << " x " << deviceNames[device] << "\n";
+            }
+        }
+    } else {
+        match = aggregateExpression.match(select);
+        if (!match.hasMatch()) {
+            error = "Invalid aggregate \"" + select + "\"";
+            return false;
+        }
+        const QString function = match.captured(1).toLower();
+        const QString columnName = match.captured(2);
+        if (columnName.isEmpty()) {
+            if (function != "count") {
+                error = "Aggregate " + function + " requires a column";
+                return false;
+            }
+            output << function << "() = " << matches << "\n";
+        } else {
+            auto column = columns.find(columnName);
+            if (column == columns.end()) {
+                error = "Unknown column " + columnName;
+                return false;
+            }
+            const qint64* values = column->second.values;
+            quint64 count = 0;
+            qint64 minValue = std::numeric_limits<qint64>::max();
+            qint64 maxValue = std::numeric_limits<qint64>::min();
+            double sum = 0.0;
+            for (quint64 row = 0; row < rowCount; row++) {
+                if (selection[row] && (values[row] != nullValue)) {
+                    count++;
+                    minValue = std::min(minValue, values[row]);
+                    maxValue = std::max(maxValue, values[row]);
+                    sum += static_cast<double>(values[row]);
+                }
+            }
+            output << function << "(" << columnName << ") = ";
+            if (function == "count") {
+                output << count;
+            } else if (count == 0) {
+                output << "n/a";
+            } else if (function == "min") {
+                output << minValue;
+            } else if (function == "max") {
+                output << maxValue;
+            } else if (function == "sum") {
+                output << QString::number(sum, 'f', 0);
+            } else {
+                output << QString::number(sum / count, 'f', 2);
+            }
+            output << "\n";
+        }
+    }
+    output << matches << " of " << rowCount << " reports matched, evaluated in " << timer.nsecsElapsed() / 1000 << " us\n";
+    output.flush();
+    return true;
+}
+
+bool ReportStore::similarTo(const QString& reportFile, int count, QString& result, QString& error)
+{
+    const ParsedReport report = parseReport(reportFile);
+    if (!report.valid) {
+        error = "Could not read report " + reportFile;
+        return false;
+    }
+    // Encode the report's extensions over the store's dictionary, extensions unknown to the store only add to the union
+    std::vector<quint64> bits(extensionWords, 0);
+    quint32 extraBits = 0;
+    for (const QString& extension : report.extensions) {
+        auto extensionId = extensionIds.find(extension);
+        if (extensionId != extensionIds.end()) {
+            bits[extensionId->second / 64] |= 1ull << (extensionId->second % 64);
+        } else {
+            extraBits++;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<double> similarities(rowCount);
+    std::vector<quint32> distances(rowCount);
+    similarityScan(bits.data(), extensionBits, rowCount, extensionWords, extraBits, similarities.data(), distances.data());
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    std::vector<quint64> rows(rowCount);
+    for (quint64 row = 0; row < rowCount; row++) {
+        rows[row] = row;
+    }
+    const quint64 topCount = std::min<quint64>(std::max(count, 1), rowCount);
+    std::partial_sort(rows.begin(), rows.begin() + topCount, rows.end(), [&similarities](quint64 a, quint64 b) {
+        return (similarities[a] != similarities[b]) ? (similarities[a] > similarities[b]) : (a < b);
+    });
+
+    QTextStream output(&result);
+    output << "Jaccard  Hamming  Device (report)\n";
+    for (quint64 i = 0; i < topCount; i++) {
+        const quint64 row = rows[i];
+        output << QString::number(similarities[row], 'f', 4) << "   " << QString::number(distances[row]).leftJustified(7) << "  " << deviceNames[deviceIds[row]] << " (" << sources[row] << ")\n";
+    }
+    const double seconds = elapsed / 1.0e9;
+    output << "Compared against " << rowCount << " reports in " << elapsed / 1000 << " us";
+    if (seconds > 0.0) {
+        output << " (" << QString::number(rowCount / seconds / 1.0e6, 'f', 2) << " M reports/s)";
+    }
+    output << "\n";
+    output.flush();
+    return true;
+}
+
+bool ReportStore::cluster(double threshold, QString& result, QString& error)
+{
+    if ((threshold <= 0.0) || (threshold > 1.0)) {
+        error = "Cluster threshold needs to be in the range (0, 1]";
+        return false;
+    }
+    QElapsedTimer timer;
+    timer.start();
+
+    // Reports with identical extension sets are collapsed first, as large corpora contain many duplicates
+    // Rows are sorted by their bitsets, so identical sets end up next to each other
+    const quint32 words = extensionWords;
+    const quint64* allBits = extensionBits;
+    std::vector<quint64> sortedRows(rowCount);
+    for (quint64 row = 0; row < rowCount; row++) {
+        sortedRows[row] = row;
+    }
+    std::sort(sortedRows.begin(), sortedRows.end(), [words, allBits](quint64 a, quint64 b) {
+        const quint64* bitsA = &allBits[a * words];
+        const quint64* bitsB = &allBits[b * words];
+        const auto mismatch = std::mismatch(bitsA, bitsA + words, bitsB);
+        return (mismatch.first != bitsA + words) ? (*mismatch.first < *mismatch.second) : (a < b);
+    });
+    // Unique set: first row and number of rows in the sorted order
+    std::vector<std::pair<quint64, quint64>> sets;
+    for (quint64 i = 0; i < rowCount; i++) {
+        if (sets.empty() || !std::equal(&allBits[sortedRows[i] * words], &allBits[sortedRows[i] * words] + words, &allBits[sortedRows[sets.back().first] * words])) {
+            sets.push_back({ i, 0 });
+        }
+        sets.back().second++;
+    }
+    // Most common feature sets become cluster leaders first
+    std::stable_sort(sets.begin(), sets.end(), [](const std::pair<quint64, quint64>& a, const std::pair<quint64, quint64>& b) { return a.second > b.second; });
+
+    // Greedy leader clustering: each set joins the first cluster whose leader is similar enough
+    // Leader bitsets are kept next to each other, as every set is compared against them
+    std::vector<quint64> leaderBits;
+    std::vector<std::vector<quint64>> clusterRows;
+    for (auto& set : sets) {
+        const quint64* bits = &allBits[sortedRows[set.first] * words];
+        qint64 target = findSimilar(bits, leaderBits.data(), clusterRows.size(), words, threshold);
+        if (target < 0) {
+            leaderBits.insert(leaderBits.end(), bits, bits + words);
+            clusterRows.emplace_back();
+            target = static_cast<qint64>(clusterRows.size()) - 1;
+        }
+        clusterRows[target].insert(clusterRows[target].end(), sortedRows.begin() + set.first, sortedRows.begin() + set.first + set.second);
+    }
+
+    QTextStream output(&result);
+    for (size_t i = 0; i < clusterRows.size(); i++) {
+        quint32 extensionCount = 0;
+        for (quint32 word = 0; word < words; word++) {
+            extensionCount += qPopulationCount(leaderBits[i * words + word]);
+        }
+        // Keyed by dictionary id, the dictionary is sorted so devices are listed by name
+        std::map<quint32, quint64> deviceCounts;
+        for (quint64 row : clusterRows[i]) {
+            deviceCounts[deviceIds[row]]++;
+        }
+        output << "Cluster " << i << ": " << clusterRows[i].size() << " reports, leader with " << extensionCount << " extensions\n";
+        for (auto& deviceCount : deviceCounts) {
+            output << "    " << deviceCount.second << " x " << deviceNames[deviceCount.first] << "\n";
+        }
+    }
+    output << clusterRows.size() << " clusters from " << sets.size() << " distinct extension sets in " << rowCount << " reports, computed in " << timer.elapsed() << " ms\n";
+    output.flush();
+    return true;
+}
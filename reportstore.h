@@ -0,0 +1,109 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef REPORTSTORE_H
+#define REPORTSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <unordered_map>
+#include <map>
+#include <QtAlgorithms>
+
+// Local columnar store for a corpus of saved device reports
+// Each device info enum value is stored as a column of 64 bit integers (one value per report),
+// extensions are dictionary encoded. All columns are plain binary files that are memory mapped for queries.
+// Additionally the extensions of each report are stored as a fixed width bitset over the extension dictionary,
+// which is used for similarity searches.
+class ReportStore
+{
+public:
+    // Marks reports that don't contain a (numerical) value for a column
+    static constexpr qint64 nullValue = std::numeric_limits<qint64>::min();
+private:
+    struct Column
+    {
+        qint32 enumValue;
+        QString name;
+        const qint64* values = nullptr;
+    };
+    struct ParsedReport
+    {
+        QString source;
+        QString deviceName;
+        std::vector<std::pair<qint32, qint64>> values;
+        QStringList extensions;
+        bool valid = false;
+    };
+    // Contents of a store as written to disk
+    struct StoreColumns
+    {
+        QStringList sources;
+        QStringList deviceNames;
+        QStringList extensionNames;
+        std::vector<quint32> deviceIds;
+        std::vector<quint32> extensionOffsets;
+        std::vector<quint32> extensionValues;
+        quint32 extensionWords = 0;
+        std::vector<quint64> extensionBits;
+        std::map<qint32, std::vector<qint64>> values;
+    };
+    QString path;
+    quint64 rowCount = 0;
+    std::vector<std::unique_ptr<QFile>> mappedFiles;
+    std::unordered_map<QString, Column> columns;
+    QStringList sources;
+    QStringList deviceNames;
+    const quint32* deviceIds = nullptr;
+    QStringList extensionNames;
+    std::unordered_map<QString, quint32> extensionIds;
+    const quint32* extensionOffsets = nullptr;
+    const quint32* extensionValues = nullptr;
+    // Number of 64 bit words per report in the extension bitset
+    quint32 extensionWords = 0;
+    const quint64* extensionBits = nullptr;
+    static ParsedReport parseReport(const QString& fileName);
+    bool writeFile(const QString& fileName, const void* data, qint64 size, QString& error);
+    bool writeDictionary(const QString& fileName, const QStringList& values, QString& error);
+    bool writeStore(const StoreColumns& store, QString& error);
+    bool readDictionary(const QString& fileName, int count, QStringList& values, QString& error);
+    const void* mapFile(const QString& fileName, qint64 expectedSize, QString& error);
+    bool filterRows(const QString& filter, std::vector<quint8>& selection, QString& error);
+public:
+    ReportStore(const QString& path);
+    bool ingest(const QString& reportDirectory, QString& error);
+    // Replaces the contents of the store with synthetic reports, used to measure queries and similarity searches on large corpora
+    bool generate(quint64 rows, QString& error);
+    bool open(QString& error);
+    bool query(const QString& expression, QString& result, QString& error);
+    bool similarTo(const QString& reportFile, int count, QString& result, QString& error);
+    bool cluster(double threshold, QString& result, QString& error);
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "roofline.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <algorithm>
+
+bool RooflineModel::valid() const
+{
+    return !points.empty() && (computeCeiling > 0.0);
+}
+
+double RooflineModel::bandwidth(const QString& memory) const
+{
+    return (memory == "local") ? localMemoryBandwidth : globalMemoryBandwidth;
+}
+
+double RooflineModel::ridgePoint(const QString& memory) const
+{
+    const double memoryBandwidth = bandwidth(memory);
+    return (memoryBandwidth > 0.0) ? computeCeiling / memoryBandwidth : 0.0;
+}
+
+double RooflineModel::attainable(const QString& memory, double intensity) const
+{
+    return std::min(computeCeiling, bandwidth(memory) * intensity);
+}
+
+void RooflineModel::deriveCeilings()
+{
+    computeCeiling = 0.0;
+    globalMemoryBandwidth = 0.0;
+    localMemoryBandwidth = 0.0;
+    for (auto& point : points) {
+        computeCeiling = std::max(computeCeiling, point.performance);
+        // GFLOPS divided by flops per byte gives GB/s, low intensity points are bound by the memory
+        const double pointBandwidth = (point.intensity > 0.0) ? point.performance / point.intensity : 0.0;
+        double& memoryBandwidth = (point.memory == "local") ? localMemoryBandwidth : globalMemoryBandwidth;
+        memoryBandwidth = std::max(memoryBandwidth, pointBandwidth);
+    }
+}
+
+QJsonObject RooflineModel::toJson() const
+{
+    QJsonObject jsonRoot;
+    jsonRoot["devicename"] = deviceName;
+    jsonRoot["driverversion"] = driverVersion;
+    QJsonObject jsonCeilings;
+    jsonCeilings["compute"] = computeCeiling;
+    jsonCeilings["globalmemory"] = globalMemoryBandwidth;
+    jsonCeilings["localmemory"] = localMemoryBandwidth;
+    jsonRoot["ceilings"] = jsonCeilings;
+    QJsonObject jsonRidgePoints;
+    jsonRidgePoints["globalmemory"] = ridgePoint("global");
+    jsonRidgePoints["localmemory"] = ridgePoint("local");
+    jsonRoot["ridgepoints"] = jsonRidgePoints;
+    QJsonArray jsonPoints;
+    for (auto& point : points) {
+        QJsonObject jsonPoint;
+        jsonPoint["memory"] = point.memory;
+        jsonPoint["intensity"] = point.intensity;
+        jsonPoint["performance"] = point.performance;
+        jsonPoints.append(jsonPoint);
+    }
+    jsonRoot["points"] = jsonPoints;
+    return jsonRoot;
+}
+
+QString RooflineModel::toCsv() const
+{
+    // One row per measured point with the roofline bound at the same intensity, so kernel profiles can be plotted against both
+    QString csv;
+    QTextStream stream(&csv);
+    stream << "device,memory,intensity (flop/byte),measured (GFLOPS),attainable (GFLOPS)\n";
+    QString escapedName = deviceName;
+    escapedName.replace("\"", "\"\"");
+    for (auto& point : points) {
+        stream << "\"" << escapedName << "\"," << point.memory << "," << point.intensity << "," << point.performance << "," << attainable(point.memory, point.intensity) << "\n";
+    }
+    return csv;
+}
+
+bool RooflineModel::exportTo(const QString& fileName, QString& error) const
+{
+    if (!valid()) {
+        error = "No roofline has been measured for this device";
+        return false;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = "Could not write " + fileName;
+        return false;
+    }
+    if (fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+        file.write(toCsv().toUtf8());
+    } else {
+        file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    }
+    return true;
+}
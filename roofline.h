@@ -0,0 +1,64 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <QString>
+#include <QJsonObject>
+#include <vector>
+
+// Measured performance of one kernel of the arithmetic intensity sweep
+struct RooflinePoint
+{
+    // "global" or "local"
+    QString memory;
+    // Floating point operations per byte moved from or to the memory
+    double intensity = 0.0;
+    // GFLOPS
+    double performance = 0.0;
+};
+
+// Compute and memory ceilings of a device, derived from kernels with controlled arithmetic intensity
+struct RooflineModel
+{
+    QString deviceName;
+    QString driverVersion;
+    // GFLOPS
+    double computeCeiling = 0.0;
+    // GB/s
+    double globalMemoryBandwidth = 0.0;
+    double localMemoryBandwidth = 0.0;
+    std::vector<RooflinePoint> points;
+    bool valid() const;
+    double bandwidth(const QString& memory) const;
+    // Intensity at which the memory ceiling meets the compute ceiling
+    double ridgePoint(const QString& memory) const;
+    // Upper bound for the performance of a kernel with the given intensity
+    double attainable(const QString& memory, double intensity) const;
+    // Highest performance and bandwidth of all points
+    void deriveCeilings();
+    QJsonObject toJson() const;
+    QString toCsv() const;
+    // Writes CSV for files ending in .csv, JSON otherwise
+    bool exportTo(const QString& fileName, QString& error) const;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "rooflinechart.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+RooflineChart::RooflineChart(QWidget* parent) : QWidget(parent)
+{
+}
+
+void RooflineChart::setRoofline(const RooflineModel& roofline)
+{
+    model = roofline;
+    update();
+}
+
+QSize RooflineChart::sizeHint() const
+{
+    return QSize(640, 360);
+}
+
+QSize RooflineChart::minimumSizeHint() const
+{
+    return QSize(320, 240);
+}
+
+void RooflineChart::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), palette().base());
+    if (!model.valid()) {
+        painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, "Run the roofline benchmark to display the roofline of this device");
+        return;
+    }
+
+    // Axis ranges are whole decades around all points and both ridge points
+    double minIntensity = std::numeric_limits<double>::max();
+    double maxIntensity = 0.0;
+    double minPerformance = model.computeCeiling;
+    for (auto& point : model.points) {
+        minIntensity = std::min(minIntensity, point.intensity);
+        maxIntensity = std::max(maxIntensity, point.intensity);
+        if (point.performance > 0.0) {
+            minPerformance = std::min(minPerformance, point.performance);
+        }
+    }
+    for (const QString memory : { "global", "local" }) {
+        const double ridgePoint = model.ridgePoint(memory);
+        if (ridgePoint > 0.0) {
+            minIntensity = std::min(minIntensity, ridgePoint);
+            maxIntensity = std::max(maxIntensity, ridgePoint);
+        }
+    }
+    const double xMin = std::floor(std::log10(minIntensity));
+    const double xMax = std::max(std::ceil(std::log10(maxIntensity)), xMin + 1.0);
+    const double yMin = std::floor(std::log10(minPerformance));
+    const double yMax = std::max(std::ceil(std::log10(model.computeCeiling * 1.5)), yMin + 1.0);
+
+    const QFontMetrics metrics(painter.font());
+    const int margin = metrics.height();
+    const QRect plot = rect().adjusted(margin * 4, margin * 2, -margin, -margin * 3);
+    auto toX = [&](double intensity) { return plot.left() + (std::log10(intensity) - xMin) / (xMax - xMin) * plot.width(); };
+    auto toY = [&](double performance) { return plot.bottom() - (std::log10(performance) - yMin) / (yMax - yMin) * plot.height(); };
+
+    // Decade grid with labels
+    const QColor textColor = palette().color(QPalette::Text);
+    QColor gridColor = textColor;
+    gridColor.setAlpha(40);
+    for (double x = xMin; x <= xMax; x += 1.0) {
+        const double px = toX(std::pow(10.0, x));
+        painter.setPen(gridColor);
+        painter.drawLine(QPointF(px, plot.top()), QPointF(px, plot.bottom()));
+        painter.setPen(textColor);
+        painter.drawText(QRectF(px - margin * 2, plot.bottom() + 2, margin * 4, margin), Qt::AlignHCenter | Qt::AlignTop, QString::number(std::pow(10.0, x), 'g', 6));
+    }
+    for (double y = yMin; y <= yMax; y += 1.0) {
+        const double py = toY(std::pow(10.0, y));
+        painter.setPen(gridColor);
+        painter.drawLine(QPointF(plot.left(), py), QPointF(plot.right(), py));
+        painter.setPen(textColor);
+        painter.drawText(QRectF(0, py - margin / 2.0, plot.left() - 4, margin), Qt::AlignRight | Qt::AlignVCenter, QString::number(std::pow(10.0, y), 'g', 6));
+    }
+    painter.setPen(textColor);
+    painter.drawRect(plot);
+    painter.drawText(QRectF(plot.left(), plot.bottom() + margin + 2, plot.width(), margin), Qt::AlignHCenter | Qt::AlignTop, "Arithmetic intensity (flop/byte)");
+    painter.save();
+    painter.translate(margin / 2.0, plot.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRectF(-plot.height() / 2.0, -margin / 2.0, plot.height(), margin), Qt::AlignCenter, "GFLOPS");
+    painter.restore();
+
+    // Roofline and measured points of each memory type
+    painter.setClipRect(plot);
+    const std::vector<std::pair<QString, QColor>> series = { { "global", QColor(0, 114, 189) }, { "local", QColor(217, 83, 25) } };
+    int legendRow = 0;
+    for (auto& entry : series) {
+        const QString& memory = entry.first;
+        const double bandwidth = model.bandwidth(memory);
+        if (bandwidth <= 0.0) {
+            continue;
+        }
+        const double ridgePoint = model.ridgePoint(memory);
+        QPainterPath roof;
+        roof.moveTo(toX(std::pow(10.0, xMin)), toY(bandwidth * std::pow(10.0, xMin)));
+        roof.lineTo(toX(ridgePoint), toY(model.computeCeiling));
+        roof.lineTo(toX(std::pow(10.0, xMax)), toY(model.computeCeiling));
+        painter.setPen(QPen(entry.second, 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPath(roof);
+        painter.setBrush(entry.second);
+        for (auto& point : model.points) {
+            if (point.memory == memory) {
+                painter.drawEllipse(QPointF(toX(point.intensity), toY(point.performance)), 3.0, 3.0);
+            }
+        }
+        const QString legend = QString("%1 memory: %2 GB/s, ridge point %3 flop/byte").arg(memory).arg(bandwidth, 0, 'f', 1).arg(ridgePoint, 0, 'f', 2);
+        painter.setPen(entry.second);
+        painter.drawText(QRectF(plot.left() + margin, plot.top() + margin * (legendRow + 2), plot.width() - margin * 2, margin), Qt::AlignLeft | Qt::AlignVCenter, legend);
+        legendRow++;
+    }
+    painter.setPen(textColor);
+    painter.drawText(QRectF(plot.left() + margin, plot.top() + margin / 2.0, plot.width() - margin * 2, margin), Qt::AlignLeft | Qt::AlignVCenter, QString("%1: %2 GFLOPS compute ceiling").arg(model.deviceName).arg(model.computeCeiling, 0, 'f', 1));
+}
@@ -0,0 +1,42 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef ROOFLINECHART_H
+#define ROOFLINECHART_H
+
+#include "roofline.h"
+#include <QWidget>
+
+// Log-log chart of the measured roofline of a device, with the ceilings drawn as lines and the measured kernels as points
+class RooflineChart : public QWidget
+{
+    Q_OBJECT
+private:
+    RooflineModel model;
+public:
+    explicit RooflineChart(QWidget* parent = nullptr);
+    void setRoofline(const RooflineModel& roofline);
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+protected:
+    void paintEvent(QPaintEvent* event) override;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#include "timercalibration.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <cmath>
+
+bool TimerCalibration::valid() const
+{
+    return samples.size() >= 2;
+}
+
+void TimerCalibration::fit()
+{
+    if (!valid()) {
+        return;
+    }
+    // Relative to the first sample, absolute timestamps are too large for fitting in double precision
+    referenceHost = samples[0].host;
+    const quint64 deviceBase = samples[0].device;
+    double meanHost = 0.0;
+    double meanDevice = 0.0;
+    for (auto& sample : samples) {
+        meanHost += double(qint64(sample.host - referenceHost));
+        meanDevice += double(qint64(sample.device - deviceBase));
+    }
+    meanHost /= samples.size();
+    meanDevice /= samples.size();
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (auto& sample : samples) {
+        const double host = double(qint64(sample.host - referenceHost)) - meanHost;
+        const double device = double(qint64(sample.device - deviceBase)) - meanDevice;
+        covariance += host * device;
+        variance += host * host;
+    }
+    scale = (variance > 0.0) ? covariance / variance : 1.0;
+    const double intercept = meanDevice - scale * meanHost;
+    referenceDevice = deviceBase + qint64(std::llround(intercept));
+    double squaredError = 0.0;
+    for (auto& sample : samples) {
+        const double host = double(qint64(sample.host - referenceHost));
+        const double device = double(qint64(sample.device - deviceBase));
+        const double error = device - (intercept + scale * host);
+        squaredError += error * error;
+    }
+    residual = std::sqrt(squaredError / samples.size());
+}
+
+double TimerCalibration::drift() const
+{
+    return (scale - 1.0) * 1.0e6;
+}
+
+double TimerCalibration::offset() const
+{
+    return double(qint64(referenceDevice - referenceHost));
+}
+
+quint64 TimerCalibration::deviceToHost(quint64 device) const
+{
+    return referenceHost + qint64(std::llround(double(qint64(device - referenceDevice)) / scale));
+}
+
+QJsonObject TimerCalibration::toJson() const
+{
+    QJsonObject jsonRoot;
+    jsonRoot["devicename"] = deviceName;
+    jsonRoot["driverversion"] = driverVersion;
+    // Timestamps are stored as strings, JSON numbers can't represent all 64 bit values
+    QJsonObject jsonModel;
+    jsonModel["referencehost"] = QString::number(referenceHost);
+    jsonModel["referencedevice"] = QString::number(referenceDevice);
+    jsonModel["scale"] = scale;
+    jsonModel["offset"] = offset();
+    jsonModel["driftppm"] = drift();
+    jsonModel["residual"] = residual;
+    jsonRoot["model"] = jsonModel;
+    QJsonObject jsonTimers;
+    jsonTimers["reportedprofilingresolution"] = qint64(reportedProfilingResolution);
+    jsonTimers["reportedhostresolution"] = qint64(reportedHostResolution);
+    jsonTimers["observedprofilingquantum"] = qint64(observedProfilingQuantum);
+    jsonTimers["observedhostquantum"] = qint64(observedHostQuantum);
+    jsonTimers["observedprofilingstep"] = qint64(observedProfilingStep);
+    jsonTimers["observedhoststep"] = qint64(observedHostStep);
+    jsonTimers["hosttimercost"] = hostTimerCost;
+    jsonTimers["deviceandhosttimercost"] = deviceAndHostTimerCost;
+    jsonRoot["timers"] = jsonTimers;
+    QJsonArray jsonSamples;
+    for (auto& sample : samples) {
+        QJsonObject jsonSample;
+        jsonSample["host"] = QString::number(sample.host);
+        jsonSample["device"] = QString::number(sample.device);
+        jsonSamples.append(jsonSample);
+    }
+    jsonRoot["samples"] = jsonSamples;
+    return jsonRoot;
+}
+
+QString TimerCalibration::toCsv() const
+{
+    // Correlation table, each sample with the host time the fitted model maps its device timestamp to
+    QString csv;
+    QTextStream stream(&csv);
+    stream << "host (ns),device (ns),device mapped to host (ns),error (ns)\n";
+    for (auto& sample : samples) {
+        const quint64 mapped = deviceToHost(sample.device);
+        stream << sample.host << "," << sample.device << "," << mapped << "," << qint64(mapped - sample.host) << "\n";
+    }
+    return csv;
+}
+
+bool TimerCalibration::exportTo(const QString& fileName, QString& error) const
+{
+    if (!valid()) {
+        error = "No timer calibration has been measured for this device";
+        return false;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = "Could not write " + fileName;
+        return false;
+    }
+    if (fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+        file.write(toCsv().toUtf8());
+    } else {
+        file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    }
+    return true;
+}
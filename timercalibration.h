@@ -0,0 +1,73 @@
+/*
+*
+* OpenCL hardware capability viewer
+*
+* Copyright (C) 2026 by Sascha Willems (www.saschawillems.de)
+*
+* This code is free software, you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License version 3 as published by the Free Software Foundation.
+*
+* Please review the following information to ensure the GNU Lesser
+* General Public License version 3 requirements will be met:
+* http://opensource.org/licenses/lgpl-3.0.html
+*
+* The code is distributed WITHOUT ANY WARRANTY; without even the
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU LGPL 3.0 for more details.
+*
+*/
+
+#ifndef TIMERCALIBRATION_H
+#define TIMERCALIBRATION_H
+
+#include <QString>
+#include <QJsonObject>
+#include <vector>
+
+// Device and host timestamps in nanoseconds taken at the same time by clGetDeviceAndHostTimer
+struct TimerSample
+{
+    quint64 device = 0;
+    quint64 host = 0;
+};
+
+// Correlation of the device timer (the timebase of profiling events) with the host timer, fitted as a line through the samples:
+// device = referenceDevice + scale * (host - referenceHost)
+struct TimerCalibration
+{
+    QString deviceName;
+    QString driverVersion;
+    std::vector<TimerSample> samples;
+    quint64 referenceHost = 0;
+    quint64 referenceDevice = 0;
+    // Device nanoseconds per host nanosecond
+    double scale = 1.0;
+    // Standard deviation of the samples from the fitted line in nanoseconds
+    double residual = 0.0;
+    // Reported and observed timer granularities in nanoseconds
+    // The quantum is the greatest common divisor of all timestamp differences, the step the smallest difference
+    quint64 reportedProfilingResolution = 0;
+    quint64 reportedHostResolution = 0;
+    quint64 observedProfilingQuantum = 0;
+    quint64 observedHostQuantum = 0;
+    quint64 observedProfilingStep = 0;
+    quint64 observedHostStep = 0;
+    // Cost of clGetHostTimer and clGetDeviceAndHostTimer in nanoseconds
+    double hostTimerCost = 0.0;
+    double deviceAndHostTimerCost = 0.0;
+    bool valid() const;
+    // Least squares fit of the samples, the first sample is used as the reference
+    void fit();
+    // Drift of the device timer against the host timer in parts per million
+    double drift() const;
+    // Device minus host timestamp at the reference point
+    double offset() const;
+    quint64 deviceToHost(quint64 device) const;
+    QJsonObject toJson() const;
+    QString toCsv() const;
+    // Writes CSV for files ending in .csv, JSON otherwise
+    bool exportTo(const QString& fileName, QString& error) const;
+};
+
+#endif